@@ -15,12 +15,24 @@ SOURCES += \
 HEADERS += \
     ZoomGraphicsView.h \
     mainwindow.h \
+    pngstream.h \
+    stringkey.h \
     treap.h \
+    treapcore.h \
+    treapexport.h \
+    treaplayout.h \
+    treapmap.h \
+    treapmultiset.h \
+    treapreclaimer.h \
+    treaptrace.h \
     visualnode.h
 
 FORMS += \
     mainwindow.ui
 
+# pngstream.h comprime las filas con deflate de la zlib del sistema
+LIBS += -lz
+
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
@@ -2,8 +2,14 @@
 #define ZOOMGRAPHICSVIEW_H
 
 #include <QGraphicsView>
+#include <QGraphicsScene>
 #include <QWheelEvent>
+#include <QMouseEvent>
+#include <QKeyEvent>
 #include <QScrollBar>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPainter>
 
 class ZoomGraphicsView : public QGraphicsView
 {
@@ -19,16 +25,135 @@ public:
         setResizeAnchor(QGraphicsView::AnchorUnderMouse);
         setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
         setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+        // Al dejar de hacer zoom o de arrastrar se recupera la calidad completa
+        settleTimer.setSingleShot(true);
+        settleTimer.setInterval(150);
+        connect(&settleTimer, &QTimer::timeout, this, &ZoomGraphicsView::endInteraction);
+    }
+
+    // Modo adaptativo: sin antialiasing mientras el usuario hace zoom o arrastra
+    void setAdaptiveQuality(bool on) {
+        adaptive = on;
+        if (!on) endInteraction();
+    }
+    bool adaptiveQuality() const { return adaptive; }
+
+    // Panel con tiempo de frame, items pintados e items en la escena (F3)
+    void setHudVisible(bool on) {
+        hudVisible = on;
+        viewport()->update();
+    }
+    bool isHudVisible() const { return hudVisible; }
+
+    // Items en uso en la escena. Lo informa quien la arma en cada refresco, para no
+    // recorrer todos los items en cada frame del panel
+    void setSceneItemCount(int count) {
+        sceneItemCount = count;
+        if (hudVisible) viewport()->update();
     }
 
 protected:
     void wheelEvent(QWheelEvent* event) override {
+        beginInteraction();
+        settleTimer.start();
+
         double scaleFactor = 1.1;
         if (event->angleDelta().y() > 0)
             scale(scaleFactor, scaleFactor);
         else
             scale(1.0 / scaleFactor, 1.0 / scaleFactor);
     }
+
+    void mousePressEvent(QMouseEvent* event) override {
+        // Un click izquierdo en el fondo (sin item debajo) empieza el arrastre con la mano
+        bool startsPan = event->button() == Qt::LeftButton && dragMode() == QGraphicsView::ScrollHandDrag
+                         && itemAt(event->pos()) == nullptr;
+        QGraphicsView::mousePressEvent(event);
+        if (startsPan) {
+            panning = true;
+            beginInteraction();
+        }
+    }
+
+    void mouseReleaseEvent(QMouseEvent* event) override {
+        QGraphicsView::mouseReleaseEvent(event);
+        if (panning) {
+            panning = false;
+            settleTimer.start();
+        }
+    }
+
+    void keyPressEvent(QKeyEvent* event) override {
+        if (event->key() == Qt::Key_F3) { setHudVisible(!hudVisible); return; }
+        QGraphicsView::keyPressEvent(event);
+    }
+
+    void paintEvent(QPaintEvent* event) override {
+        QElapsedTimer timer;
+        timer.start();
+        QGraphicsView::paintEvent(event);
+        lastFrameMs = timer.nsecsElapsed() / 1e6;
+    }
+
+    void drawForeground(QPainter* painter, const QRectF& rect) override {
+        if (!hudVisible || !scene()) return;
+
+        // Solo interesa la cantidad; ordenar los items a la vista es despreciable
+        // frente a pintarlos, y el panel es una herramienta de diagnóstico
+        int painted = scene()->items(rect, Qt::IntersectsItemBoundingRect, Qt::AscendingOrder).size();
+        QString text = QString("Frame: %1 ms (anterior)\nItems pintados: %2\nItems en escena: %3%4")
+                           .arg(lastFrameMs, 0, 'f', 2)
+                           .arg(painted)
+                           .arg(sceneItemCount)
+                           .arg(interacting ? QString("\nModo rápido") : QString());
+
+        painter->save();
+        painter->resetTransform(); // coordenadas del viewport
+        QRectF box(8, 8, 190, interacting ? 70 : 56);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor(0, 0, 0, 160));
+        painter->drawRect(box);
+        painter->setPen(Qt::white);
+        painter->drawText(box.adjusted(6, 4, -6, -4), Qt::AlignLeft | Qt::AlignTop, text);
+        painter->restore();
+    }
+
+private slots:
+    void endInteraction() {
+        if (!interacting || panning) return;
+        interacting = false;
+        setRenderHints(savedHints);
+        setViewportUpdateMode(savedUpdateMode);
+        setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing, false);
+        // Los nodos usan caché en coordenadas del item, pintada siempre con antialiasing
+        // y válida a cualquier escala: no hay pixmaps que descartar, alcanza con
+        // repintar la vista con los hints completos
+        viewport()->update();
+    }
+
+private:
+    QTimer settleTimer;
+    bool adaptive = true;
+    bool interacting = false;
+    bool panning = false;
+    bool hudVisible = false;
+    double lastFrameMs = 0;
+    int sceneItemCount = 0;
+    QPainter::RenderHints savedHints;
+    QGraphicsView::ViewportUpdateMode savedUpdateMode = QGraphicsView::MinimalViewportUpdate;
+
+    void beginInteraction() {
+        if (!adaptive || interacting) return;
+        interacting = true;
+        savedHints = renderHints();
+        savedUpdateMode = viewportUpdateMode();
+        setRenderHints(QPainter::RenderHints());
+        // Una sola región rectangular por frame en lugar de calcular la región
+        // exacta de cada nodo animado; el desplazamiento sigue usando blit
+        setViewportUpdateMode(QGraphicsView::BoundingRectViewportUpdate);
+        setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing, true);
+    }
 };
 
 #endif
@@ -0,0 +1,551 @@
+// Benchmarks de consola para el motor del Treap (sin Qt).
+// Uso: treap_bench <seccion> [argumentos]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <map>
+#include "treap.h"
+#include "shardedtreap.h"
+#include "treaptrace.h"
+#include "treapmultiset.h"
+#include "treapmap.h"
+#include "treapservice.h"
+#include <unordered_map>
+#include <atomic>
+#include <algorithm>
+#include <csignal>
+#include <set>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static std::vector<int> randomKeys(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, std::numeric_limits<int>::max() - 1);
+    std::vector<int> keys(n);
+    for (auto& k : keys) k = dist(rng);
+    return keys;
+}
+
+// --- SHARDED ---
+// Inserta y busca n claves aleatorias en lotes, con 1, 2, 4, 8... shards, y compara
+// con un Treap único como referencia. Dos corridas por cantidad de shards:
+//   balanced: splitters en cuantiles de la distribución (sin rebalanceos), para
+//             juzgar el escalado;
+//   skewed:   splitters malos (todo cae en el primer shard), incluye el costo de
+//             rebalancear con split/join.
+// El reparto de cada lote corre en serie en este hilo: con núcleos de sobra, el
+// techo lo pone el reparto y no los shards.
+static int benchSharded(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 2000000;
+    size_t batch = argc > 1 ? std::stoul(argv[1]) : 65536;
+    unsigned maxShards = argc > 2 ? std::stoul(argv[2]) : std::max(8u, std::thread::hardware_concurrency());
+
+    std::vector<int> keys = randomKeys(n, 42);
+    std::cout << "núcleos " << std::thread::hardware_concurrency()
+              << " (el reparto de lotes es serial en el hilo que llama)\n";
+
+    {
+        Treap<int> t;
+        auto start = Clock::now();
+        for (int k : keys) t.insert(k);
+        double ins = secondsSince(start);
+        start = Clock::now();
+        size_t found = 0;
+        for (int k : keys) found += t.search(k);
+        double look = secondsSince(start);
+        std::cout << "treap              shards=1   insert " << std::setw(10) << size_t(n / ins) << " ops/s"
+                  << "   search " << std::setw(10) << size_t(n / look) << " ops/s"
+                  << "   (found " << found << ")\n";
+    }
+
+    for (bool balanced : { true, false }) {
+        for (unsigned shards = 1; shards <= maxShards; shards *= 2) {
+            // randomKeys es uniforme en [0, INT_MAX - 1]: los cuantiles son cortes parejos
+            std::vector<int> splitters;
+            for (unsigned i = 1; i < shards; i++) {
+                if (balanced) splitters.push_back(int((long long)(std::numeric_limits<int>::max() - 1) * i / shards));
+                else splitters.push_back(std::numeric_limits<int>::max() - int(shards - i));
+            }
+            ShardedTreap<int> st(splitters);
+
+            auto start = Clock::now();
+            for (size_t i = 0; i < n; i += batch) {
+                std::vector<int> b(keys.begin() + i, keys.begin() + std::min(n, i + batch));
+                st.insertBatch(b);
+            }
+            double ins = secondsSince(start);
+
+            start = Clock::now();
+            size_t found = 0;
+            for (size_t i = 0; i < n; i += batch) {
+                std::vector<int> b(keys.begin() + i, keys.begin() + std::min(n, i + batch));
+                for (char r : st.searchBatch(b)) found += r;
+            }
+            double look = secondsSince(start);
+
+            size_t smallest = st.shardSize(0), largest = st.shardSize(0);
+            for (size_t i = 1; i < st.shardCount(); i++) {
+                smallest = std::min(smallest, st.shardSize(i));
+                largest = std::max(largest, st.shardSize(i));
+            }
+
+            std::cout << "sharded " << std::left << std::setw(9) << (balanced ? "balanced" : "skewed")
+                      << "  shards=" << std::setw(4) << shards << std::right
+                      << "insert " << std::setw(10) << size_t(n / ins) << " ops/s"
+                      << "   search " << std::setw(10) << size_t(n / look) << " ops/s"
+                      << "   (found " << found << ", rebalances " << st.rebalanceCount()
+                      << ", shard sizes " << smallest << ".." << largest << ")\n";
+        }
+    }
+    return 0;
+}
+
+// --- BATCH ---
+// Compara un bucle de search()+insert()/remove() contra insertBatch/eraseBatch
+// para lotes de distintos tamaños sobre un treap base de n claves.
+static int benchBatch(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 1000000;
+    std::vector<int> base = randomKeys(n, 7);
+
+    for (size_t m : { size_t(1000), size_t(10000), size_t(100000), size_t(1000000) }) {
+        std::vector<int> batch = randomKeys(m, unsigned(m));
+
+        Treap<int> loop, bulk;
+        loop.insertBatch(base);
+        bulk.insertBatch(base);
+
+        auto start = Clock::now();
+        size_t added = 0;
+        for (int k : batch) added += loop.insert(k);
+        double loopIns = secondsSince(start);
+
+        start = Clock::now();
+        size_t addedBatch = bulk.insertBatch(batch);
+        double bulkIns = secondsSince(start);
+
+        start = Clock::now();
+        for (int k : batch) loop.remove(k);
+        double loopDel = secondsSince(start);
+
+        start = Clock::now();
+        size_t removedBatch = bulk.eraseBatch(batch);
+        double bulkDel = secondsSince(start);
+
+        std::cout << "m=" << std::left << std::setw(8) << m << std::right << std::fixed << std::setprecision(4)
+                  << " insert loop " << loopIns << "s  batch " << bulkIns << "s (x" << std::setprecision(1) << loopIns / bulkIns << ")"
+                  << std::setprecision(4)
+                  << "   erase loop " << loopDel << "s  batch " << bulkDel << "s (x" << std::setprecision(1) << loopDel / bulkDel << ")"
+                  << "   added " << added << "/" << addedBatch << " removed " << removedBatch << "\n";
+    }
+    return 0;
+}
+
+// --- REPLAY ---
+// Reproduce una traza grabada con 'Treap_visual --record' a máxima velocidad.
+static int benchReplay(int argc, char** argv) {
+    if (argc < 1) { std::cerr << "Uso: treap_bench replay <traza> [--timing]\n"; return 1; }
+    bool timing = argc > 1 && std::string(argv[1]) == "--timing";
+
+    TreapTrace::ReplayResult r;
+    try {
+        r = TreapTrace::replay(argv[0], timing);
+    } catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::cout << r.operations << " operaciones en " << std::fixed << std::setprecision(4) << r.seconds << "s ("
+              << size_t(r.operations / std::max(r.seconds, 1e-9)) << " ops/s)\n";
+    for (auto const& [op, s] : r.perOp) {
+        std::cout << "  " << std::left << std::setw(14) << TreapTrace::opName(op) << std::right
+                  << std::setw(10) << s.count << " ops   media " << std::setw(10) << s.totalNs / s.count
+                  << " ns   max " << std::setw(10) << s.maxNs << " ns\n";
+    }
+    return 0;
+}
+
+// --- FINGER ---
+// Claves crecientes y casi ordenadas (cada una cae cerca del máximo):
+// insert()/search() desde la raíz contra fingerInsert()/fingerSearch() desde el máximo.
+static int benchFinger(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 2000000;
+    int window = argc > 1 ? std::stoi(argv[1]) : 64;
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> jitter(0, std::max(0, window - 1));
+    std::vector<int> monotonic(n), nearSorted(n);
+    for (size_t i = 0; i < n; i++) {
+        monotonic[i] = int(i) * 4;
+        nearSorted[i] = int(i) * 4 - jitter(rng) * 4 + 1; // hasta 'window' posiciones detrás del máximo
+    }
+
+    for (auto const& [label, keys] : { std::make_pair("monotonic", &monotonic), std::make_pair("near-sorted", &nearSorted) }) {
+        Treap<int> root, finger;
+        root.seedPriorities(3);
+        finger.seedPriorities(3);
+
+        auto start = Clock::now();
+        for (int k : *keys) root.insert(k);
+        double rootIns = secondsSince(start);
+
+        start = Clock::now();
+        for (int k : *keys) finger.fingerInsert(k);
+        double fingerIns = secondsSince(start);
+
+        // Búsquedas de claves recientes (cerca del máximo)
+        start = Clock::now();
+        size_t found = 0;
+        for (size_t i = n - std::min<size_t>(n, 1000); i < n; i++)
+            for (int d = 0; d < 100; d++) found += root.search((*keys)[i] - d);
+        double rootLook = secondsSince(start);
+
+        start = Clock::now();
+        size_t foundFinger = 0;
+        for (size_t i = n - std::min<size_t>(n, 1000); i < n; i++)
+            for (int d = 0; d < 100; d++) foundFinger += finger.fingerSearch((*keys)[i] - d);
+        double fingerLook = secondsSince(start);
+
+        std::cout << std::left << std::setw(12) << label << std::right << std::fixed << std::setprecision(4)
+                  << " insert " << rootIns << "s  finger " << fingerIns << "s (x" << std::setprecision(1) << rootIns / fingerIns << ")"
+                  << std::setprecision(4)
+                  << "   search " << rootLook << "s  finger " << fingerLook << "s (x" << std::setprecision(1) << rootLook / fingerLook << ")"
+                  << "   found " << found << "/" << foundFinger << "\n";
+    }
+    return 0;
+}
+
+// --- STRINGS ---
+// Treap<std::string> (prefijo en el nodo + resto en el arena, stringkey.h) contra
+// el nodo genérico guardando un std::string completo.
+struct PlainString {
+    std::string s;
+    PlainString() = default;
+    PlainString(const std::string& s_) : s(s_) {}
+    bool operator<(const PlainString& o) const { return s < o.s; }
+};
+
+template <typename K>
+static void benchStringTreap(const char* label, const std::vector<std::string>& keys, const std::vector<std::string>& probes) {
+    Treap<K> t;
+    t.seedPriorities(5);
+    auto start = Clock::now();
+    for (const auto& k : keys) t.insert(k);
+    double ins = secondsSince(start);
+
+    start = Clock::now();
+    size_t found = 0;
+    for (const auto& k : probes) found += t.search(k);
+    double look = secondsSince(start);
+
+    std::cout << "  " << std::left << std::setw(12) << label << std::right
+              << " insert " << std::setw(10) << size_t(keys.size() / ins) << " ops/s"
+              << "   search " << std::setw(10) << size_t(probes.size() / look) << " ops/s"
+              << "   (found " << found << ")\n";
+}
+
+static int benchStrings(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 1000000;
+    std::mt19937 rng(13);
+
+    // Claves aleatorias (el prefijo casi siempre decide) y claves con un prefijo
+    // común largo (empatan en los 8 bytes y hay que leer el resto)
+    std::vector<std::string> random(n), prefixed(n);
+    for (size_t i = 0; i < n; i++) {
+        std::string s(12 + rng() % 20, ' ');
+        for (char& c : s) c = char('a' + rng() % 26);
+        random[i] = s;
+        prefixed[i] = "usuarios/" + std::to_string(rng() % (n * 4)) + "/perfil";
+    }
+
+    for (auto const& [label, keys] : { std::make_pair("random", &random), std::make_pair("prefixed", &prefixed) }) {
+        std::vector<std::string> probes(*keys);
+        std::shuffle(probes.begin(), probes.end(), rng);
+        std::cout << label << " (" << n << " claves)\n";
+        benchStringTreap<PlainString>("std::string", *keys, probes);
+        benchStringTreap<std::string>("prefix+arena", *keys, probes);
+    }
+    return 0;
+}
+
+// --- MULTISET ---
+// n inserciones y n/2 eliminaciones sobre pocas claves distintas: TreapMultiset
+// (un nodo con contador por clave) contra std::multiset (un nodo por repetición).
+static int benchMultiset(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 2000000;
+    int distinct = argc > 1 ? std::stoi(argv[1]) : 1000;
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> pick(0, std::max(1, distinct) - 1);
+    std::vector<int> keys(n);
+    for (auto& k : keys) k = pick(rng);
+
+    std::multiset<int> ref;
+    auto start = Clock::now();
+    for (int k : keys) ref.insert(k);
+    double refIns = secondsSince(start);
+    start = Clock::now();
+    for (size_t i = 0; i < n / 2; i++) { auto it = ref.find(keys[i]); if (it != ref.end()) ref.erase(it); }
+    double refDel = secondsSince(start);
+
+    TreapMultiset<int> t;
+    start = Clock::now();
+    for (int k : keys) t.insert(k);
+    double ins = secondsSince(start);
+    start = Clock::now();
+    for (size_t i = 0; i < n / 2; i++) t.erase(keys[i]);
+    double del = secondsSince(start);
+
+    start = Clock::now();
+    size_t counted = 0;
+    for (size_t i = 0; i < n; i++) counted += t.countRange(keys[i], keys[i] + distinct / 10);
+    double ranges = secondsSince(start);
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "std::multiset  insert " << refIns << "s   erase " << refDel << "s   (" << ref.size() << " nodos)\n"
+              << "TreapMultiset  insert " << ins << "s   erase " << del << "s   (" << t.size() << " elementos)\n"
+              << "countRange     " << size_t(n / ranges) << " consultas/s (suma " << counted << ")\n";
+    return 0;
+}
+
+// --- MAP ---
+// TreapMap con agregado de suma y de mínimo: inserta, reemplaza y borra n claves,
+// corta y vuelve a unir, y compara cada query() contra la suma/mínimo recorriendo
+// el rango en un std::map. Sale con 1 si algún resultado no coincide.
+static int benchMap(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 200000;
+    size_t queries = argc > 1 ? std::stoul(argv[1]) : 2000;
+
+    std::mt19937 rng(23);
+    int keySpace = int(std::max<size_t>(n, 1) * 4);
+    std::uniform_int_distribution<int> key(0, keySpace), value(-1000, 1000);
+
+    TreapMap<int, long long, SumAggregate<long long>> sum;
+    TreapMap<int, long long, MinAggregate<long long>> min;
+    std::map<int, long long> ref;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < n; i++) {
+        int k = key(rng);
+        long long v = value(rng);
+        if (i % 4 == 3) { sum.remove(k); min.remove(k); ref.erase(k); }
+        else { sum.insert(k, v); min.insert(k, v); ref[k] = v; }
+    }
+    double build = secondsSince(start);
+
+    // Cortar y volver a unir debe dejar los agregados intactos
+    int cut = keySpace / 2;
+    {
+        decltype(sum) low, high;
+        sum.split(cut, low, high);
+        sum.join(low, high);
+        decltype(min) lowMin, highMin;
+        min.split(cut, lowMin, highMin);
+        min.join(lowMin, highMin);
+    }
+
+    std::vector<std::pair<int, int>> ranges(queries);
+    for (auto& r : ranges) {
+        int a = key(rng), b = key(rng);
+        r = { std::min(a, b), std::max(a, b) };
+    }
+
+    size_t mismatches = 0;
+    start = Clock::now();
+    std::vector<long long> sums, mins;
+    for (auto& r : ranges) {
+        sums.push_back(sum.query(r.first, r.second));
+        mins.push_back(min.query(r.first, r.second));
+    }
+    double fast = secondsSince(start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < queries; i++) {
+        long long s = 0, m = std::numeric_limits<long long>::max();
+        for (auto it = ref.lower_bound(ranges[i].first); it != ref.end() && it->first <= ranges[i].second; ++it) {
+            s += it->second;
+            m = std::min(m, it->second);
+        }
+        if (s != sums[i] || m != mins[i]) mismatches++;
+    }
+    double brute = secondsSince(start);
+
+    long long all = 0;
+    for (auto const& [k, v] : ref) all += v;
+    if (sum.total() != all) mismatches++;
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "construcción   " << build << "s   (" << ref.size() << " claves, suma y mínimo)\n"
+              << "query()        " << size_t(2 * queries / fast) << " consultas/s\n"
+              << "recorrido      " << size_t(2 * queries / brute) << " consultas/s (std::map)\n"
+              << (mismatches ? "ERROR: " : "ok: ") << mismatches << " resultados distintos de "
+              << queries * 2 + 1 << "\n";
+    return mismatches ? 1 : 0;
+}
+
+// --- SERVICE ---
+// Generador de carga para treapd: cada conexión crea su treap "load-<i>" y mantiene
+// 'profundidad' pedidos en vuelo (50% insert, 30% search, 15% erase, 5% range) de
+// 'lote' claves durante 'segundos'. Informa throughput y latencia por pedido.
+static int benchService(int argc, char** argv) {
+    std::string path = argc > 0 ? argv[0] : TreapService::DEFAULT_SOCKET;
+    unsigned connections = argc > 1 ? std::stoul(argv[1]) : 4;
+    size_t batch = argc > 2 ? std::stoul(argv[2]) : 64;
+    unsigned depth = argc > 3 ? std::stoul(argv[3]) : 16;
+    double duration = argc > 4 ? std::stod(argv[4]) : 5.0;
+    std::signal(SIGPIPE, SIG_IGN);
+
+    using namespace TreapService;
+    std::vector<std::vector<uint64_t>> latencies(connections); // ns por pedido
+    std::vector<size_t> errors(connections, 0);
+    std::atomic<bool> failed{false};
+
+    auto worker = [&](unsigned c) {
+        Client client;
+        if (!client.connect(path)) { failed = true; return; }
+        std::string name = "load-" + std::to_string(c);
+        std::mt19937 rng(c + 1);
+        std::uniform_int_distribution<int> key(0, 1 << 24);
+        Frame f;
+
+        // Treap propio, vacío (se descarta el de una corrida anterior)
+        Encoder setup;
+        setup.drop(0, name);
+        setup.create(1, name);
+        if (!client.send(setup) || !client.receive(f) || !client.receive(f)) { failed = true; return; }
+
+        std::unordered_map<uint32_t, Clock::time_point> inFlight;
+        uint32_t nextId = 2;
+        std::vector<int> keys(batch);
+        Encoder e;
+        auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+
+        while (true) {
+            bool sending = Clock::now() < end;
+            if (!sending && inFlight.empty()) break;
+
+            // Completa la ventana de pedidos en vuelo con un solo write
+            e.clear();
+            while (sending && inFlight.size() < depth) {
+                uint32_t id = nextId++;
+                unsigned r = rng() % 100;
+                if (r < 95) {
+                    for (int& k : keys) k = key(rng);
+                    e.batch(id, r < 50 ? Op::Insert : r < 80 ? Op::Search : Op::Erase, name, keys);
+                } else {
+                    int lo = key(rng);
+                    e.range(id, name, lo, lo + 1024, uint32_t(batch));
+                }
+                inFlight[id] = Clock::now();
+            }
+            if (!e.empty() && !client.send(e)) { failed = true; return; }
+
+            if (!client.receive(f)) { failed = true; return; }
+            auto it = inFlight.find(f.id);
+            if (it == inFlight.end()) continue;
+            latencies[c].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - it->second).count());
+            if (Status(f.code) != Status::Ok) errors[c]++;
+            inFlight.erase(it);
+        }
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned c = 0; c < connections; c++) threads.emplace_back(worker, c);
+    for (auto& t : threads) t.join();
+    double elapsed = secondsSince(start);
+    if (failed) { std::cerr << "Error de conexión con " << path << " (¿está corriendo treapd?)\n"; return 1; }
+
+    std::vector<uint64_t> all;
+    size_t errorCount = 0;
+    for (unsigned c = 0; c < connections; c++) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        errorCount += errors[c];
+    }
+    if (all.empty()) { std::cerr << "Sin respuestas\n"; return 1; }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[std::min(all.size() - 1, size_t(p * all.size()))] / 1000.0; };
+
+    std::cout << connections << " conexiones, lote " << batch << ", profundidad " << depth << ", " << std::fixed
+              << std::setprecision(2) << elapsed << "s\n"
+              << "  " << size_t(all.size() / elapsed) << " pedidos/s   " << size_t(all.size() * batch / elapsed)
+              << " claves/s   errores " << errorCount << "\n"
+              << "  latencia us: p50 " << percentile(0.50) << "   p99 " << percentile(0.99)
+              << "   p99.9 " << percentile(0.999) << "   max " << all.back() / 1000.0 << "\n";
+    return 0;
+}
+
+// --- ERASE-RANGE ---
+// Quitar un rango de k claves: bucle de remove() contra eraseRange(), y vaciar un
+// treap de n claves con clear() contra clearDeferred(). Se mide el tiempo de quien
+// llama y, aparte, lo que tarda el hilo de fondo en liberar los nodos.
+static int benchEraseRange(int argc, char** argv) {
+    size_t n = argc > 0 ? std::stoul(argv[0]) : 2000000;
+    std::vector<int> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = int(i);
+
+    for (size_t k : { size_t(1000), size_t(100000), n / 2 }) {
+        int lo = int(n / 4), hi = int(n / 4 + k - 1);
+        Treap<int> loop, ranged;
+        loop.insertBatch(keys);
+        ranged.insertBatch(keys);
+
+        auto start = Clock::now();
+        for (int key = lo; key <= hi; key++) loop.remove(key);
+        double loopTime = secondsSince(start);
+
+        start = Clock::now();
+        ranged.eraseRange(lo, hi);
+        double rangeTime = secondsSince(start);
+        TreapReclaimer::instance().drain();
+        double freed = secondsSince(start);
+
+        std::cout << "k=" << std::left << std::setw(8) << k << std::right << std::fixed << std::setprecision(6)
+                  << " remove loop " << loopTime << "s   eraseRange " << rangeTime << "s (liberado en " << freed << "s)"
+                  << "   quedan " << ranged.search(lo - 1) + ranged.search(hi + 1) << "/2 bordes\n";
+    }
+
+    Treap<int> a, b;
+    a.insertBatch(keys);
+    b.insertBatch(keys);
+    auto start = Clock::now();
+    a.clear();
+    double clearTime = secondsSince(start);
+    start = Clock::now();
+    b.clearDeferred();
+    double deferredTime = secondsSince(start);
+    TreapReclaimer::instance().drain();
+    std::cout << "n=" << n << std::fixed << std::setprecision(6) << " clear " << clearTime << "s   clearDeferred "
+              << deferredTime << "s (liberado en " << secondsSince(start) << "s)\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::map<std::string, std::function<int(int, char**)>> sections = {
+        { "sharded", benchSharded },
+        { "batch", benchBatch },
+        { "replay", benchReplay },
+        { "finger", benchFinger },
+        { "strings", benchStrings },
+        { "multiset", benchMultiset },
+        { "map", benchMap },
+        { "service", benchService },
+        { "erase-range", benchEraseRange },
+    };
+
+    if (argc < 2 || sections.find(argv[1]) == sections.end()) {
+        std::cerr << "Uso: treap_bench <seccion> [argumentos]\nSecciones:";
+        for (auto const& [name, fn] : sections) std::cerr << " " << name;
+        std::cerr << "\n";
+        return 1;
+    }
+    return sections[argv[1]](argc - 2, argv + 2);
+}
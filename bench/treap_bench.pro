@@ -0,0 +1,23 @@
+TEMPLATE = app
+TARGET = treap_bench
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+unix: LIBS += -lpthread
+
+SOURCES += \
+    treap_bench.cpp
+
+HEADERS += \
+    ../treap.h \
+    ../treapcore.h \
+    ../stringkey.h \
+    ../treapreclaimer.h \
+    ../shardedtreap.h \
+    ../treaptrace.h \
+    ../treapmap.h \
+    ../treapmultiset.h \
+    ../treapservice.h
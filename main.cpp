@@ -1,9 +1,26 @@
 #include "mainwindow.h"
+#include "treapexport.h"
 #include <QApplication>
 
 int main(int argc, char *argv[]) {
+    // Modo sin pantalla: exporta un treap a PNG/SVG sin abrir la ventana
+    for (int i = 1; i < argc; i++) {
+        if (QString(argv[i]) == "--export") {
+            if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+            QApplication a(argc, argv);
+            return TreapExport::runFromArguments(a.arguments());
+        }
+    }
+
     QApplication a(argc, argv);
     MainWindow w;
+
+    // --record traza.bin: guarda todas las operaciones para reproducirlas con treap_bench replay
+    QStringList args = a.arguments();
+    int rec = args.indexOf("--record");
+    if (rec >= 0 && rec + 1 < args.size() && !w.startTrace(args[rec + 1]))
+        qWarning("No se pudo abrir la traza %s", qPrintable(args[rec + 1]));
+
     w.show();
     return a.exec();
 }
@@ -4,6 +4,23 @@
 #include <cmath>
 #include <QGraphicsTextItem>
 #include <limits> // Necesario para min/max
+#include <algorithm>
+#include <QRegularExpression>
+#include <QRandomGenerator>
+#include <QPixmapCache>
+
+// Varias claves separadas por comas o espacios ("10, 20 30") se procesan como lote.
+// Devuelve una lista vacía si alguna parte no es un entero.
+static std::vector<int> parseKeyList(const QString& txt) {
+    std::vector<int> keys;
+    for (const QString& part : txt.split(QRegularExpression("[,\\s]+"), Qt::SkipEmptyParts)) {
+        bool ok = false;
+        int key = part.toInt(&ok);
+        if (!ok) return {};
+        keys.push_back(key);
+    }
+    return keys;
+}
 
 // --- IMPLEMENTACIÓN MAINWINDOW ---
 
@@ -11,12 +28,21 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , scene(new QGraphicsScene(this))
+    , refreshTimer(new QTimer(this))
 {
     ui->setupUi(this);
     ui->graphicsView->setScene(scene);
 
-    // Mapa infinito
-    scene->setSceneRect(-5000, -5000, 10000, 10000);
+    // Cada VisualNode guarda en QPixmapCache un pixmap de 60×70 ARGB (~16 KB). Con el
+    // límite por defecto (10 MB) entran unos 600 y un árbol grande a la vista se
+    // volvería a rasterizar en cada frame; 160 MB alcanza para unos 10000 nodos
+    QPixmapCache::setCacheLimit(std::max(QPixmapCache::cacheLimit(), 160 * 1024));
+
+    // Las operaciones se aplican al motor al instante; la escena se reconstruye
+    // una sola vez por frame aunque lleguen muchas operaciones seguidas
+    refreshTimer->setSingleShot(true);
+    refreshTimer->setInterval(16);
+    connect(refreshTimer, &QTimer::timeout, this, &MainWindow::updateVisualization);
 
     treaps["Main"] = new Treap<int>();
     selectedTree1 = "Main";
@@ -32,7 +58,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->deleteTreapButton, &QPushButton::clicked, this, &MainWindow::onDeleteTreapClicked);
 
     updateStatus();
-    updateVisualization();
+    scheduleVisualization();
 }
 
 MainWindow::~MainWindow() {
@@ -40,10 +66,24 @@ MainWindow::~MainWindow() {
     delete ui;
 }
 
-int MainWindow::calculateSubtreeWidth(TreapNode<int>* node) {
-    if (!node) return 0;
-    // Esto es "peso" lógico, no píxeles. Sirve para la separación interna.
-    return 1 + calculateSubtreeWidth(node->left) + calculateSubtreeWidth(node->right);
+bool MainWindow::startTrace(const QString& path) {
+    auto writer = std::make_unique<TreapTrace::Writer>();
+    if (!writer->open(path.toStdString())) return false;
+
+    // Estado inicial: reinsertar en preorden con las mismas prioridades reconstruye la misma forma
+    for (auto const& [name, t] : treaps) {
+        writer->create(name.toStdString());
+        std::vector<TreapNode<int>*> stack;
+        if (t->getRoot()) stack.push_back(t->getRoot());
+        while (!stack.empty()) {
+            TreapNode<int>* n = stack.back(); stack.pop_back();
+            writer->insert(name.toStdString(), n->key, n->priority);
+            if (n->right) stack.push_back(n->right);
+            if (n->left) stack.push_back(n->left);
+        }
+    }
+    trace = std::move(writer);
+    return true;
 }
 
 QString MainWindow::generateUniqueName(QString base) {
@@ -53,33 +93,77 @@ QString MainWindow::generateUniqueName(QString base) {
     return base + "_" + QString::number(i);
 }
 
-// --- VISUALIZACIÓN ---
+// --- ÍNDICE DE ENRUTAMIENTO ---
+
+// Actualiza el rango [min, max] cacheado de un treap (O(log n))
+void MainWindow::refreshBounds(const QString& name) {
+    auto it = treaps.find(name);
+    if (it == treaps.end() || it->second->empty()) { dropBounds(name); return; }
+    TreapBounds b = { it->second->minKey(), it->second->maxKey() };
+    auto cached = treapBounds.find(name);
+    if (cached != treapBounds.end() && cached->second.minKey == b.minKey && cached->second.maxKey == b.maxKey)
+        return; // el rango no cambió: el índice sigue valiendo
+    treapBounds[name] = b;
+    routeIndexDirty = true;
+}
 
-// Calcula posiciones RELATIVAS al centro (0,0) del árbol
-void MainWindow::recursivePosCalculation(TreapNode<int>* node, int x, int y, int width, QString owner, QColor color, std::map<TreapNode<int>*, QPointF>& targetPositions) {
-    if (!node) return;
-    targetPositions[node] = QPointF(x, y);
+void MainWindow::dropBounds(const QString& name) {
+    if (treapBounds.erase(name)) routeIndexDirty = true;
+}
+
+// Reconstruye el vector ordenado por minKey con el máximo acumulado de maxKey,
+// que permite consultar qué rangos contienen una clave sin recorrer todo el bosque
+void MainWindow::rebuildRouteIndex() {
+    routeIndex.clear();
+    for (auto const& [name, b] : treapBounds)
+        routeIndex.push_back({ b.minKey, b.maxKey, b.maxKey, name });
 
-    int offset = width * 25;
-    if (width < 2) offset = 50;
+    std::sort(routeIndex.begin(), routeIndex.end(),
+              [](const RouteEntry& a, const RouteEntry& b) { return a.minKey < b.minKey; });
 
-    int leftW = calculateSubtreeWidth(node->left);
-    int rightW = calculateSubtreeWidth(node->right);
+    for (size_t i = 1; i < routeIndex.size(); i++)
+        routeIndex[i].maxUpTo = std::max(routeIndex[i].maxKey, routeIndex[i - 1].maxUpTo);
 
-    recursivePosCalculation(node->left, x - offset, y + 80, leftW, owner, color, targetPositions);
-    recursivePosCalculation(node->right, x + offset, y + 80, rightW, owner, color, targetPositions);
+    routeIndexDirty = false;
 }
 
-void MainWindow::updateVisualization() {
-    // 1. Limpiar elementos temporales
-    for (auto item : tempItems) {
-        scene->removeItem(item);
-        delete item;
+// Devuelve el treap que contiene la clave, o "" si ninguno.
+// Búsqueda binaria y solo se consultan los treaps cuyo rango cubre la clave: O(log T)
+// mientras los rangos sean disjuntos. La interfaz permite rangos solapados (insertar
+// en cualquier treap); con k rangos que cubren la clave el recorrido hacia atrás es
+// O(k), hasta O(T). Cada inserción que cambia un mínimo o máximo marca el índice y la
+// siguiente consulta lo reconstruye en O(T log T).
+QString MainWindow::findOwner(int key) {
+    if (routeIndexDirty) rebuildRouteIndex();
+
+    auto it = std::upper_bound(routeIndex.begin(), routeIndex.end(), key,
+                               [](int k, const RouteEntry& e) { return k < e.minKey; });
+
+    while (it != routeIndex.begin()) {
+        --it;
+        if (it->maxUpTo < key) break; // ningún rango anterior llega hasta la clave
+        if (it->maxKey < key) continue;
+        auto owner = treaps.find(it->name);
+        if (owner != treaps.end() && owner->second->search(key)) return it->name;
     }
-    tempItems.clear();
+    return "";
+}
 
-    std::map<TreapNode<int>*, QPointF> allNodesPositions;
+// --- VISUALIZACIÓN ---
+
+void MainWindow::scheduleVisualization() {
+    if (!refreshTimer->isActive()) refreshTimer->start();
+}
+
+void MainWindow::updateVisualization() {
+    // Los items se reciclan: cada nodo lógico conserva su VisualNode, y las
+    // etiquetas y flechas se toman en orden de sus pools
+    visualGeneration++;
+    size_t labelsUsed = 0, edgesUsed = 0;
+    // Las operaciones que llevaron a este refresco pasan al disco juntas
+    if (trace) trace->flush();
     int currentX = 100; // Donde empieza a dibujarse el primer árbol
+    QRectF bounds; // cajas de los nodos
 
     // Recorremos cada árbol
     for (auto const& [name, tree] : treaps) {
@@ -88,12 +172,8 @@ void MainWindow::updateVisualization() {
 
         // CASO 1: ÁRBOL VACÍO
         if (tree->empty()) {
-            ClickableTreeLabel* placeholder = new ClickableTreeLabel(name, isSel, true);
+            ClickableTreeLabel* placeholder = placeLabel(labelsUsed++, name, isSel, true);
             placeholder->setPos(currentX, 50);
-            connect(placeholder, &ClickableTreeLabel::labelClicked, this, &MainWindow::onNodeVisualClicked);
-
-            scene->addItem(placeholder);
-            tempItems.push_back(placeholder);
 
             currentX += 200; // Espacio fijo para el placeholder
             continue;
@@ -101,121 +181,146 @@ void MainWindow::updateVisualization() {
 
         // CASO 2: ÁRBOL LLENO - CALCULO INTELIGENTE DE ANCHO
 
-        // A. Calculamos posiciones "locales" asumiendo que la raíz está en X=0
-        std::map<TreapNode<int>*, QPointF> localPositions;
-        int w = calculateSubtreeWidth(tree->getRoot());
-        QColor c = QColor(255, 255, 160);
-        if (isSel) c = Qt::cyan;
-
-        recursivePosCalculation(tree->getRoot(), 0, 60, w, name, c, localPositions);
+        // A. Layout "local" con la raíz en X=0
+        TreapLayout::Tidy<int> layout(tree->getRoot());
 
         // B. Encontramos los límites reales (Bounding Box) de este árbol
-        float minX = std::numeric_limits<float>::max();
-        float maxX = std::numeric_limits<float>::lowest();
-
-        for (auto const& [node, pos] : localPositions) {
-            if (pos.x() < minX) minX = pos.x();
-            if (pos.x() > maxX) maxX = pos.x();
-        }
+        qreal minX = std::numeric_limits<qreal>::max();
+        qreal maxX = std::numeric_limits<qreal>::lowest();
+        layout.visit(QPointF(0, 60), [&](TreapNode<int>*, const QPointF& pos, const QPointF*) {
+            minX = std::min(minX, pos.x());
+            maxX = std::max(maxX, pos.x());
+            return true;
+        });
 
         // C. Calculamos cuánto hay que mover para que no se solape
         // Queremos que el borde izquierdo (minX) empiece en currentX
-        // Shift = currentX - minX
-        float shiftX = currentX - minX;
-
-        // D. Guardamos las posiciones finales ajustadas
-        for (auto const& [node, pos] : localPositions) {
-            QPointF finalPos(pos.x() + shiftX, pos.y());
-            allNodesPositions[node] = finalPos;
-        }
+        qreal shiftX = currentX - minX;
+
+        // D. Nodos y flechas en su posición final
+        QColor c = isSel ? QColor(Qt::cyan) : QColor(255, 255, 160);
+        const QString& owner = name; // un structured binding no se puede capturar en C++17
+        layout.visit(QPointF(shiftX, 60), [&](TreapNode<int>* node, const QPointF& pos, const QPointF* parent) {
+            placeNode(node, pos, owner, c, isSel);
+            if (parent) placeEdge(edgesUsed++, *parent, pos);
+            bounds |= QRectF(pos.x() - 30, pos.y() - 45, 60, 70);
+            return true;
+        });
 
         // E. Dibujar el nombre del árbol centrado en su espacio real
-        float treeRealWidth = maxX - minX;
-        float centerOfTree = currentX + (treeRealWidth / 2.0);
+        qreal treeRealWidth = maxX - minX;
+        qreal centerOfTree = currentX + (treeRealWidth / 2.0);
 
-        ClickableTreeLabel* lbl = new ClickableTreeLabel(name, isSel, false);
+        ClickableTreeLabel* lbl = placeLabel(labelsUsed++, name, isSel, false);
         qreal lblWidth = lbl->boundingRect().width();
         lbl->setPos(centerOfTree - lblWidth/2, 0);
-        connect(lbl, &ClickableTreeLabel::labelClicked, this, &MainWindow::onNodeVisualClicked);
-        scene->addItem(lbl);
-        tempItems.push_back(lbl);
 
         // F. Actualizar currentX para el siguiente árbol (+ margen de 100px)
         currentX += treeRealWidth + 150;
     }
 
-    // --- AHORA DIBUJAMOS LOS NODOS USANDO LAS POSICIONES CALCULADAS ---
-    for (auto const& [logicNode, pos] : allNodesPositions) {
-        QString owner = "";
-        for(auto const& [n, t] : treaps) {
-            if(t->search(logicNode->key)) { owner = n; break; }
-        }
+    // Los nodos que ya no existen vuelven al pool
+    auto it = visualMap.begin();
+    while (it != visualMap.end()) {
+        if (it->second.generation != visualGeneration) {
+            VisualNode* v = it->second.item;
+            v->stopAnimation();
+            v->setVisible(false);
+            nodePool.push_back(v);
+            it = visualMap.erase(it);
+        } else ++it;
+    }
+    releaseUnused(labelsUsed, edgesUsed);
+    ui->graphicsView->setSceneItemCount(int(visualMap.size() + edgesUsed + labelsUsed));
 
-        QColor c = QColor(255, 255, 160);
-        bool isSel = false;
-        if (owner == selectedTree1 || owner == selectedTree2) {
-            c = Qt::cyan;
-            isSel = true;
-        }
+    // El rectángulo de la escena se ajusta al contenido (con margen para arrastrar),
+    // en lugar de un mapa fijo: el índice BSP de la escena queda proporcional al árbol
+    bounds |= QRectF(0, -100, currentX + 100, 200); // etiquetas y entrada animada desde y = -100
+    scene->setSceneRect(bounds.adjusted(-1000, -1000, 1000, 1000));
+}
 
-        if (visualMap.find(logicNode) == visualMap.end()) {
-            // NUEVO
-            VisualNode* v = new VisualNode(logicNode->key, logicNode->priority, owner, c);
+void MainWindow::placeNode(TreapNode<int>* node, const QPointF& pos, const QString& owner, const QColor& color, bool selected) {
+    auto it = visualMap.find(node);
+    bool fresh = it == visualMap.end();
+    if (fresh) {
+        VisualNode* v;
+        if (!nodePool.empty()) {
+            v = nodePool.back();
+            nodePool.pop_back();
+        } else {
+            // La señal se conecta una sola vez, al crear el item
+            v = new VisualNode(node->key, node->priority, owner, color);
             connect(v, &VisualNode::nodeClicked, this, &MainWindow::onNodeVisualClicked);
             scene->addItem(v);
-            v->setPos(pos.x(), -100);
-            v->animateTo(pos);
-            v->setSelected(isSel);
-            visualMap[logicNode] = v;
-        } else {
-            // EXISTENTE
-            VisualNode* v = visualMap[logicNode];
-            // Verificar integridad por si hubo reutilización de memoria
-            if (v->key != logicNode->key || v->priority != logicNode->priority) {
-                scene->removeItem(v); delete v;
-                VisualNode* nv = new VisualNode(logicNode->key, logicNode->priority, owner, c);
-                connect(nv, &VisualNode::nodeClicked, this, &MainWindow::onNodeVisualClicked);
-                scene->addItem(nv);
-                nv->setPos(pos);
-                nv->setSelected(isSel);
-                visualMap[logicNode] = nv;
-            } else {
-                v->ownerName = owner;
-                v->setColor(c);
-                v->setSelected(isSel);
-                v->animateTo(pos);
-            }
         }
+        it = visualMap.emplace(node, BoundNode{ v, 0 }).first;
     }
 
-    // Limpieza de nodos que ya no existen
-    auto it = visualMap.begin();
-    while (it != visualMap.end()) {
-        if (allNodesPositions.find(it->first) == allNodesPositions.end()) {
-            scene->removeItem(it->second); delete it->second;
-            it = visualMap.erase(it);
-        } else ++it;
+    VisualNode* v = it->second.item;
+    // Una dirección reutilizada con otra clave es un nodo nuevo para la animación
+    if (v->key != node->key || v->priority != node->priority) fresh = true;
+    if (fresh) {
+        v->rebind(node->key, node->priority);
+        v->stopAnimation();
+        v->setPos(pos.x(), -100);
+        v->setVisible(true);
     }
+    v->ownerName = owner;
+    v->setColor(color);
+    v->setSelected(selected);
+    v->animateTo(pos);
+    it->second.generation = visualGeneration;
+}
 
-    // Dibujar Flechas
-    for (auto const& [logicNode, pos] : allNodesPositions) {
-        if (logicNode->left && allNodesPositions.count(logicNode->left)) {
-            QPointF p2 = allNodesPositions[logicNode->left];
-            QGraphicsLineItem* li = scene->addLine(pos.x(), pos.y()+20, p2.x(), p2.y()-20, QPen(Qt::black, 2));
-            li->setZValue(0); tempItems.push_back(li);
-        }
-        if (logicNode->right && allNodesPositions.count(logicNode->right)) {
-            QPointF p2 = allNodesPositions[logicNode->right];
-            QGraphicsLineItem* li = scene->addLine(pos.x(), pos.y()+20, p2.x(), p2.y()-20, QPen(Qt::black, 2));
-            li->setZValue(0); tempItems.push_back(li);
-        }
+void MainWindow::placeEdge(size_t index, const QPointF& from, const QPointF& to) {
+    if (index == edgeItems.size()) {
+        QGraphicsLineItem* li = scene->addLine(QLineF(), QPen(Qt::black, 2));
+        li->setZValue(0);
+        edgeItems.push_back(li);
+    }
+    QGraphicsLineItem* li = edgeItems[index];
+    li->setLine(from.x(), from.y() + 20, to.x(), to.y() - 20);
+    li->setVisible(true);
+}
+
+ClickableTreeLabel* MainWindow::placeLabel(size_t index, const QString& name, bool selected, bool empty) {
+    if (index == treeLabels.size()) {
+        ClickableTreeLabel* lbl = new ClickableTreeLabel(name, selected, empty);
+        connect(lbl, &ClickableTreeLabel::labelClicked, this, &MainWindow::onNodeVisualClicked);
+        scene->addItem(lbl);
+        treeLabels.push_back(lbl);
+    }
+    ClickableTreeLabel* lbl = treeLabels[index];
+    lbl->rebind(name, selected, empty);
+    lbl->setVisible(true);
+    return lbl;
+}
+
+// Oculta lo que sobró en este refresco. Los pools guardan a lo sumo otro tanto
+// de lo que está en uso (mínimo 256), así no retienen memoria tras borrar un árbol grande
+void MainWindow::releaseUnused(size_t labelsUsed, size_t edgesUsed) {
+    for (size_t i = labelsUsed; i < treeLabels.size(); i++) treeLabels[i]->setVisible(false);
+
+    size_t keepEdges = std::max<size_t>(256, 2 * edgesUsed);
+    while (edgeItems.size() > keepEdges) {
+        delete edgeItems.back(); // el destructor lo quita de la escena
+        edgeItems.pop_back();
+    }
+    for (size_t i = edgesUsed; i < edgeItems.size(); i++) edgeItems[i]->setVisible(false);
+
+    size_t keepNodes = std::max<size_t>(256, visualMap.size());
+    while (nodePool.size() > keepNodes) {
+        delete nodePool.back();
+        nodePool.pop_back();
     }
 }
 
 // --- INTERACCIÓN ---
 
 void MainWindow::onNodeVisualClicked(QString ownerName) {
-    if (ownerName.isEmpty()) return;
+    // Hasta el próximo refresco (diferido) la escena puede mostrar items de un treap
+    // que ya se dividió, unió o eliminó: su nombre no debe quedar seleccionado
+    if (ownerName.isEmpty() || treaps.find(ownerName) == treaps.end()) return;
 
     if (selectedTree1 == ownerName) {
         selectedTree1 = "";
@@ -229,7 +334,7 @@ void MainWindow::onNodeVisualClicked(QString ownerName) {
         selectedTree1 = ownerName;
     }
     updateStatus();
-    updateVisualization();
+    scheduleVisualization();
 }
 
 void MainWindow::updateStatus() {
@@ -245,16 +350,37 @@ void MainWindow::onInsertClicked() {
     if (selectedTree1.isEmpty()) { ui->statusLabel->setText("Selecciona un Treap."); return; }
     QString txt = ui->keyLineEdit->text();
     if (txt.isEmpty()) return;
-    int val = txt.toInt();
+
+    std::vector<int> keys = parseKeyList(txt);
+    if (keys.empty()) { ui->statusLabel->setText("Clave inválida."); return; }
+    if (keys.size() > 1) {
+        unsigned seed = 0;
+        if (trace) {
+            seed = QRandomGenerator::global()->generate();
+            treaps[selectedTree1]->seedPriorities(seed);
+            trace->insertBatch(selectedTree1.toStdString(), seed, keys);
+        }
+        size_t added = treaps[selectedTree1]->insertBatch(keys);
+        refreshBounds(selectedTree1);
+        scheduleVisualization();
+        ui->statusLabel->setText("Insertadas " + QString::number(added) + " claves en " + selectedTree1);
+        ui->keyLineEdit->clear(); ui->keyLineEdit->setFocus();
+        return;
+    }
+
+    int val = keys[0];
 
     if (treaps[selectedTree1]->search(val)) {
         ui->statusLabel->setText("Clave ya existe en " + selectedTree1);
         return;
     }
 
-    treaps[selectedTree1]->insert(val);
+    int priority = treaps[selectedTree1]->nextPriority();
+    treaps[selectedTree1]->insert(val, priority);
+    if (trace) trace->insert(selectedTree1.toStdString(), val, priority);
+    refreshBounds(selectedTree1);
 
-    updateVisualization();
+    scheduleVisualization();
     ui->keyLineEdit->clear();
     ui->keyLineEdit->setFocus();
 }
@@ -263,21 +389,50 @@ void MainWindow::onDeleteClicked() {
     if (selectedTree1.isEmpty()) return;
     QString txt = ui->keyLineEdit->text();
     if (txt.isEmpty()) return;
-    int val = txt.toInt();
+
+    // Rango "lo..hi": dos splits y un merge; los nodos se liberan en segundo plano
+    static const QRegularExpression rangeRe("^\\s*(-?\\d+)\\s*\\.\\.\\s*(-?\\d+)\\s*$");
+    QRegularExpressionMatch range = rangeRe.match(txt);
+    if (range.hasMatch()) {
+        int lo = range.captured(1).toInt(), hi = range.captured(2).toInt();
+        bool removed = treaps[selectedTree1]->eraseRange(lo, hi);
+        if (trace) trace->eraseRange(selectedTree1.toStdString(), lo, hi);
+        refreshBounds(selectedTree1);
+        scheduleVisualization();
+        ui->statusLabel->setText(removed ? QString("Rango [%1, %2] eliminado de %3").arg(lo).arg(hi).arg(selectedTree1)
+                                         : QString("No hay claves en [%1, %2]").arg(lo).arg(hi));
+        ui->keyLineEdit->clear(); ui->keyLineEdit->setFocus();
+        return;
+    }
+
+    std::vector<int> keys = parseKeyList(txt);
+    if (keys.empty()) { ui->statusLabel->setText("Clave inválida."); return; }
+    if (keys.size() > 1) {
+        size_t removed = treaps[selectedTree1]->eraseBatch(keys);
+        if (trace) trace->eraseBatch(selectedTree1.toStdString(), keys);
+        refreshBounds(selectedTree1);
+        scheduleVisualization();
+        ui->statusLabel->setText("Eliminadas " + QString::number(removed) + " claves de " + selectedTree1);
+        ui->keyLineEdit->clear(); ui->keyLineEdit->setFocus();
+        return;
+    }
+
+    int val = keys[0];
     treaps[selectedTree1]->remove(val);
-    updateVisualization();
+    if (trace) trace->remove(selectedTree1.toStdString(), val);
+    refreshBounds(selectedTree1);
+    scheduleVisualization();
     ui->keyLineEdit->clear(); ui->keyLineEdit->setFocus();
 }
 
 void MainWindow::onSearchClicked() {
     int val = ui->keyLineEdit->text().toInt();
-    for (auto const& [name, t] : treaps) {
-        if (t->search(val)) {
-            selectedTree1 = name; selectedTree2 = "";
-            updateStatus(); updateVisualization();
-            ui->statusLabel->setText("Encontrado en: " + name);
-            return;
-        }
+    QString name = findOwner(val);
+    if (!name.isEmpty()) {
+        selectedTree1 = name; selectedTree2 = "";
+        updateStatus(); scheduleVisualization();
+        ui->statusLabel->setText("Encontrado en: " + name);
+        return;
     }
     ui->statusLabel->setText("No encontrado.");
 }
@@ -304,12 +459,15 @@ void MainWindow::onSplitClicked() {
 
     try {
         treaps[selectedTree1]->split(key, *TL, *TR);
+        if (trace) trace->split(selectedTree1.toStdString(), key, nameL.toStdString(), nameR.toStdString());
         delete treaps[selectedTree1]; treaps.erase(selectedTree1);
+        dropBounds(selectedTree1);
 
         treaps[nameL] = TL; treaps[nameR] = TR;
+        refreshBounds(nameL); refreshBounds(nameR);
         selectedTree1 = nameL; selectedTree2 = nameR;
 
-        updateStatus(); updateVisualization();
+        updateStatus(); scheduleVisualization();
         ui->statusLabel->setText("Split OK en: " + QString::number(key));
 
     } catch (std::exception& e) {
@@ -338,14 +496,17 @@ void MainWindow::onJoinClicked() {
 
     try {
         TM->join(*T1, *T2);
+        if (trace) trace->join(selectedTree1.toStdString(), selectedTree2.toStdString(), newName.toStdString());
 
         delete treaps[selectedTree1]; treaps.erase(selectedTree1);
         delete treaps[selectedTree2]; treaps.erase(selectedTree2);
+        dropBounds(selectedTree1); dropBounds(selectedTree2);
 
         treaps[newName] = TM;
+        refreshBounds(newName);
         selectedTree1 = newName; selectedTree2 = "";
 
-        updateStatus(); updateVisualization();
+        updateStatus(); scheduleVisualization();
         ui->statusLabel->setText("Join OK.");
 
     } catch (std::exception& e) {
@@ -357,14 +518,18 @@ void MainWindow::onJoinClicked() {
 void MainWindow::onCreateTreapClicked() {
     QString name = generateUniqueName("NewTree");
     treaps[name] = new Treap<int>();
+    if (trace) trace->create(name.toStdString());
     selectedTree1 = name; selectedTree2 = "";
-    updateVisualization();
+    scheduleVisualization();
 }
 
 void MainWindow::onDeleteTreapClicked() {
     if (selectedTree1.isEmpty()) return;
+    treaps[selectedTree1]->clearDeferred(); // no se liberan millones de nodos en el hilo de la interfaz
     delete treaps[selectedTree1];
     treaps.erase(selectedTree1);
+    dropBounds(selectedTree1);
+    if (trace) trace->deleteTreap(selectedTree1.toStdString());
     selectedTree1 = "";
-    updateStatus(); updateVisualization();
+    updateStatus(); scheduleVisualization();
 }
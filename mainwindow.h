@@ -3,9 +3,15 @@
 
 #include <QMainWindow>
 #include <QGraphicsScene>
+#include <QTimer>
+#include <QGraphicsLineItem>
 #include <map>
+#include <vector>
+#include <memory>
 #include "treap.h"
 #include "visualnode.h"
+#include "treaplayout.h"
+#include "treaptrace.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -19,6 +25,9 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    // Registra cada operación del espacio de trabajo en una traza binaria (treaptrace.h)
+    bool startTrace(const QString& path);
+
 private slots:
     void onInsertClicked();
     void onDeleteClicked();
@@ -34,20 +43,45 @@ private slots:
 private:
     Ui::MainWindow *ui;
     QGraphicsScene *scene;
+    QTimer *refreshTimer; // agrupa varias operaciones en un solo refresco de la escena
 
     std::map<QString, Treap<int>*> treaps;
     QString selectedTree1;
     QString selectedTree2;
 
-    std::map<TreapNode<int>*, VisualNode*> visualMap;
-    QList<QGraphicsItem*> tempItems; // Lista genérica para textos y líneas
+    // Índice de enrutamiento clave -> treap: rango [min, max] cacheado por treap
+    struct TreapBounds { int minKey; int maxKey; };
+    struct RouteEntry { int minKey; int maxKey; int maxUpTo; QString name; };
+    std::map<QString, TreapBounds> treapBounds;
+    std::vector<RouteEntry> routeIndex; // ordenado por minKey
+    bool routeIndexDirty = true;
+
+    std::unique_ptr<TreapTrace::Writer> trace;
+
+    // Items de la escena reciclados entre refrescos: nada se borra ni se vuelve a
+    // conectar; lo que sobra se oculta y queda en el pool para el próximo uso
+    struct BoundNode { VisualNode* item; unsigned generation; };
+    std::map<TreapNode<int>*, BoundNode> visualMap; // identidad: dirección + clave + prioridad
+    std::vector<VisualNode*> nodePool;              // ocultos, listos para reusar
+    std::vector<ClickableTreeLabel*> treeLabels;    // los primeros 'labelsUsed' están visibles
+    std::vector<QGraphicsLineItem*> edgeItems;      // los primeros 'edgesUsed' están visibles
+    unsigned visualGeneration = 0;
+
+    void placeNode(TreapNode<int>* node, const QPointF& pos, const QString& owner, const QColor& color, bool selected);
+    void placeEdge(size_t index, const QPointF& from, const QPointF& to);
+    ClickableTreeLabel* placeLabel(size_t index, const QString& name, bool selected, bool empty);
+    void releaseUnused(size_t labelsUsed, size_t edgesUsed);
 
-    int calculateSubtreeWidth(TreapNode<int>* node);
     void updateVisualization();
-    void recursivePosCalculation(TreapNode<int>* node, int x, int y, int width, QString owner, QColor color, std::map<TreapNode<int>*, QPointF>& targetPositions);
+    void scheduleVisualization();
     void updateStatus();
 
     QString generateUniqueName(QString base);
+
+    void refreshBounds(const QString& name);
+    void dropBounds(const QString& name);
+    void rebuildRouteIndex();
+    QString findOwner(int key);
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,107 @@
+#ifndef PNGSTREAM_H
+#define PNGSTREAM_H
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <zlib.h>
+
+// Escritor de PNG (RGB de 8 bits) que recibe la imagen fila por fila y la
+// escribe al disco sin tenerla completa en memoria. Cada fila pasa por deflate()
+// de zlib y la salida se escribe en chunks IDAT a medida que se llena el buffer,
+// así que la memoria es una fila más el buffer de salida.
+class PngStreamWriter {
+    QFile file;
+    quint32 width = 0;
+    quint32 height = 0;
+    quint32 rowsWritten = 0;
+    z_stream zs{};
+    bool deflating = false;
+    QByteArray out;         // salida de deflate pendiente de escribir como IDAT
+
+    static constexpr int IDAT_CHUNK = 1 << 16;
+    // La imagen es casi toda fondo blanco: el nivel más rápido ya la reduce a poco
+    static constexpr int LEVEL = Z_BEST_SPEED;
+
+    static void appendBE32(QByteArray& data, quint32 v) {
+        data.append(char(v >> 24)); data.append(char(v >> 16));
+        data.append(char(v >> 8));  data.append(char(v));
+    }
+
+    void writeChunk(const char type[4], const char* data, quint32 size) {
+        QByteArray head;
+        appendBE32(head, size);
+        head.append(type, 4);
+        quint32 crc = quint32(::crc32(0, reinterpret_cast<const Bytef*>(type), 4));
+        if (size > 0) crc = quint32(::crc32(crc, reinterpret_cast<const Bytef*>(data), size));
+        QByteArray tail;
+        appendBE32(tail, crc);
+        file.write(head);
+        if (size > 0) file.write(data, size);
+        file.write(tail);
+    }
+
+    // Pasa 'size' bytes por deflate y escribe un IDAT cada vez que se llena 'out'.
+    // Con Z_FINISH sigue hasta vaciar el compresor. Devuelve false si zlib falla.
+    bool feed(const char* data, size_t size, int flush) {
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        zs.avail_in = uInt(size);
+        while (true) {
+            zs.next_out = reinterpret_cast<Bytef*>(out.data());
+            zs.avail_out = uInt(out.size());
+            int rc = deflate(&zs, flush);
+            if (rc == Z_STREAM_ERROR) return false;
+            quint32 produced = quint32(out.size()) - zs.avail_out;
+            if (produced > 0) writeChunk("IDAT", out.constData(), produced);
+            if (flush == Z_FINISH ? rc == Z_STREAM_END : zs.avail_in == 0 && zs.avail_out != 0) return true;
+        }
+    }
+
+public:
+    ~PngStreamWriter() { if (deflating) deflateEnd(&zs); }
+
+    bool open(const QString& path, quint32 w, quint32 h) {
+        file.setFileName(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+        width = w; height = h;
+        if (deflateInit(&zs, LEVEL) != Z_OK) { file.close(); return false; }
+        deflating = true;
+        out.resize(IDAT_CHUNK);
+
+        file.write("\x89PNG\r\n\x1a\n", 8);
+        QByteArray ihdr;
+        appendBE32(ihdr, w);
+        appendBE32(ihdr, h);
+        ihdr.append(char(8));  // bits por canal
+        ihdr.append(char(2));  // RGB
+        ihdr.append(char(0)); ihdr.append(char(0)); ihdr.append(char(0));
+        writeChunk("IHDR", ihdr.constData(), quint32(ihdr.size()));
+        return true;
+    }
+
+    // 'rgb' apunta a width * 3 bytes
+    void writeRow(const uchar* rgb) {
+        if (!deflating || rowsWritten >= height) return;
+        const char filter = 0; // sin filtro
+        bool ok = feed(&filter, 1, Z_NO_FLUSH)
+                  && feed(reinterpret_cast<const char*>(rgb), 3 * size_t(width), Z_NO_FLUSH);
+        if (!ok) { deflateEnd(&zs); deflating = false; return; }
+        rowsWritten++;
+    }
+
+    bool close() {
+        if (!file.isOpen()) return false;
+        bool complete = deflating && rowsWritten == height;
+        if (deflating) {
+            complete = feed(nullptr, 0, Z_FINISH) && complete;
+            deflateEnd(&zs);
+            deflating = false;
+        }
+        writeChunk("IEND", nullptr, 0);
+        file.close();
+        return complete;
+    }
+};
+
+#endif // PNGSTREAM_H
@@ -0,0 +1,450 @@
+// treapd: servicio local que hospeda treaps con nombre y los sirve por un socket Unix.
+// Uso: treapd [--socket ruta]
+//
+// Cada treap tiene su propio hilo ejecutor: los pedidos de todas las conexiones
+// sobre un mismo treap se ejecutan en orden de llegada, y treaps distintos avanzan
+// en paralelo. Cada conexión tiene un hilo lector (decodifica y reparte) y uno
+// escritor (junta las respuestas pendientes en un solo write).
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <csignal>
+#include <poll.h>
+#include <sys/stat.h>
+#include "treap.h"
+#include "treapservice.h"
+
+using namespace TreapService;
+
+// --- EJECUTOR ---
+class Executor {
+public:
+    typedef std::function<void(Treap<int>&)> Task;
+
+    explicit Executor(std::unique_ptr<Treap<int>> t) : treap(std::move(t)), thread(&Executor::run, this) {}
+    ~Executor() { if (thread.joinable()) detach(); }
+
+    // false si el ejecutor ya se está deteniendo (el treap fue quitado del registro)
+    bool post(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return false;
+            queue.push_back(std::move(task));
+        }
+        cv.notify_one();
+        return true;
+    }
+
+    // Termina las tareas pendientes, detiene el hilo y devuelve el treap
+    std::unique_ptr<Treap<int>> detach() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        thread.join();
+        return std::move(treap);
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Task> queue;
+    bool stopping = false;
+    std::unique_ptr<Treap<int>> treap;
+    std::thread thread; // último: arranca con todo lo anterior ya construido
+
+    void run() {
+        std::vector<Task> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return !queue.empty() || stopping; });
+                if (queue.empty()) return; // stopping y sin pendientes
+                batch.swap(queue);
+            }
+            for (Task& task : batch) task(*treap);
+            batch.clear();
+        }
+    }
+};
+
+// --- REGISTRO DE TREAPS ---
+// Un nombre con ejecutor nulo está reservado por un split/join en curso: los
+// pedidos sobre él reciben Status::Busy, distinto de un nombre que no existe.
+class Registry {
+public:
+    Status find(const std::string& name, std::shared_ptr<Executor>& executor) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = treaps.find(name);
+        if (it == treaps.end()) return Status::UnknownTreap;
+        if (!it->second) return Status::Busy;
+        executor = it->second;
+        return Status::Ok;
+    }
+
+    Status create(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = treaps.find(name);
+        if (it != treaps.end()) return it->second ? Status::AlreadyExists : Status::Busy;
+        treaps[name] = std::make_shared<Executor>(std::make_unique<Treap<int>>());
+        return Status::Ok;
+    }
+
+    // Quita los orígenes y reserva los destinos; los destinos pueden repetir un origen.
+    // Si falla, 'culprit' es el nombre que lo impidió.
+    Status reserve(const std::vector<std::string>& sources, const std::vector<std::string>& targets,
+                   std::vector<std::shared_ptr<Executor>>& taken, std::string& culprit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < sources.size(); i++) {
+            culprit = sources[i];
+            auto it = treaps.find(sources[i]);
+            if (it == treaps.end()) return Status::UnknownTreap;
+            if (!it->second) return Status::Busy;
+            for (size_t j = 0; j < i; j++) if (sources[j] == sources[i]) return Status::BadRequest;
+        }
+        for (size_t i = 0; i < targets.size(); i++) {
+            culprit = targets[i];
+            bool isSource = std::find(sources.begin(), sources.end(), targets[i]) != sources.end();
+            auto it = treaps.find(targets[i]);
+            if (!isSource && it != treaps.end()) return it->second ? Status::AlreadyExists : Status::Busy;
+            for (size_t j = 0; j < i; j++) if (targets[j] == targets[i]) return Status::BadRequest;
+        }
+        culprit.clear();
+        for (const auto& name : sources) { taken.push_back(treaps[name]); treaps[name] = nullptr; }
+        for (const auto& name : targets) treaps[name] = nullptr;
+        return Status::Ok;
+    }
+
+    // Publica los treaps resultantes y libera las reservas que quedaron sin usar
+    void publish(const std::vector<std::string>& reserved, std::map<std::string, std::unique_ptr<Treap<int>>> results) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& name : reserved) treaps.erase(name);
+        for (auto& [name, treap] : results) treaps[name] = std::make_shared<Executor>(std::move(treap));
+    }
+
+    Status take(const std::string& name, std::shared_ptr<Executor>& executor) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = treaps.find(name);
+        if (it == treaps.end()) return Status::UnknownTreap;
+        if (!it->second) return Status::Busy;
+        executor = it->second;
+        treaps.erase(it);
+        return Status::Ok;
+    }
+
+    void clear() {
+        std::map<std::string, std::shared_ptr<Executor>> all;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            all.swap(treaps);
+        }
+        all.clear(); // cada ejecutor termina lo pendiente y se detiene
+    }
+
+private:
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<Executor>> treaps;
+};
+
+// --- CONEXIÓN ---
+class Connection : public std::enable_shared_from_this<Connection> {
+public:
+    Connection(int fd_, Registry& registry_, std::atomic<int>& active_)
+        : fd(fd_), registry(registry_), active(active_), writer(&Connection::writeLoop, this) {
+        active++;
+    }
+
+    ~Connection() {
+        {
+            std::lock_guard<std::mutex> lock(outMutex);
+            closing = true;
+        }
+        outCv.notify_one();
+        writer.join();
+        ::close(fd);
+        active--;
+    }
+
+    // Se llama desde el hilo lector o desde los ejecutores
+    void send(const Encoder& e) {
+        {
+            std::lock_guard<std::mutex> lock(outMutex);
+            if (broken) return;
+            out += e.data();
+        }
+        outCv.notify_one();
+    }
+
+    void readLoop() {
+        FrameReader reader(fd);
+        Frame frame;
+        while (reader.next(frame)) {
+            try {
+                handle(frame);
+            } catch (std::exception& ex) {
+                reply(frame.id, Status::BadRequest, ex.what());
+            }
+        }
+    }
+
+private:
+    int fd;
+    Registry& registry;
+    std::atomic<int>& active;
+    std::mutex outMutex;
+    std::condition_variable outCv;
+    std::string out;
+    bool closing = false;
+    bool broken = false;
+    std::thread writer;
+
+    void writeLoop() {
+        std::string chunk;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(outMutex);
+                outCv.wait(lock, [this] { return !out.empty() || closing; });
+                if (out.empty()) return;
+                chunk.swap(out);
+            }
+            if (!writeAll(fd, chunk.data(), chunk.size())) {
+                std::lock_guard<std::mutex> lock(outMutex);
+                broken = true; // el cliente se fue; se descartan las respuestas
+                out.clear();
+            }
+            chunk.clear();
+        }
+    }
+
+    void reply(uint32_t id, Status s, const std::string& message = std::string()) {
+        Encoder e;
+        e.status(id, s, message);
+        send(e);
+    }
+
+    // Manda la tarea al ejecutor del treap; la respuesta la arma la tarea.
+    // Si el ejecutor se detuvo entre la búsqueda y el envío (drop, split o join en
+    // curso), se vuelve a buscar: el nombre puede estar reservado, haber desaparecido
+    // o haberse publicado de nuevo.
+    void dispatch(uint32_t id, const std::string& name, std::function<void(Treap<int>&, Encoder&)> work) {
+        auto self = shared_from_this();
+        auto task = [self, id, work = std::move(work)](Treap<int>& t) {
+            Encoder e;
+            e.begin(id, uint8_t(Status::Ok));
+            work(t, e);
+            e.end();
+            self->send(e);
+        };
+        while (true) {
+            std::shared_ptr<Executor> executor;
+            Status s = registry.find(name, executor);
+            if (s != Status::Ok) { reply(id, s, name); return; }
+            if (executor->post(task)) return;
+        }
+    }
+
+    void handle(const Frame& frame) {
+        Decoder in(frame);
+        uint32_t id = frame.id;
+
+        switch (Op(frame.code)) {
+        case Op::Create: {
+            std::string name = in.getName();
+            Status s = registry.create(name);
+            reply(id, s, name);
+            break;
+        }
+        case Op::Drop: {
+            std::string name = in.getName();
+            std::shared_ptr<Executor> executor;
+            Status s = registry.take(name, executor);
+            if (s != Status::Ok) { reply(id, s, name); break; }
+            executor->detach(); // termina lo pendiente antes de liberar el treap
+            reply(id, Status::Ok);
+            break;
+        }
+        case Op::Insert:
+        case Op::Erase:
+        case Op::Search: {
+            Op op = Op(frame.code);
+            std::string name = in.getName();
+            std::vector<int> keys;
+            in.getKeys(keys);
+            dispatch(id, name, [op, keys = std::move(keys)](Treap<int>& t, Encoder& e) {
+                if (op == Op::Insert) e.put<uint32_t>(uint32_t(t.insertBatch(keys)));
+                else if (op == Op::Erase) e.put<uint32_t>(uint32_t(t.eraseBatch(keys)));
+                else {
+                    std::vector<char> found(keys.size());
+                    for (size_t i = 0; i < keys.size(); i++) found[i] = t.search(keys[i]);
+                    e.put<uint32_t>(uint32_t(found.size()));
+                    e.putBytes(found.data(), found.size());
+                }
+            });
+            break;
+        }
+        case Op::Range: {
+            std::string name = in.getName();
+            int lo = in.get<int32_t>(), hi = in.get<int32_t>();
+            uint32_t limit = std::min(in.get<uint32_t>(), MAX_RANGE_KEYS);
+            dispatch(id, name, [lo, hi, limit](Treap<int>& t, Encoder& e) {
+                std::vector<int> keys;
+                t.range(lo, hi, keys, limit);
+                e.putKeys(keys);
+            });
+            break;
+        }
+        case Op::Split: {
+            std::string source = in.getName();
+            int key = in.get<int32_t>();
+            std::string left = in.getName(), right = in.getName();
+            rebuild(id, { source }, { left, right }, [&](std::vector<std::unique_ptr<Treap<int>>>& src) {
+                std::map<std::string, std::unique_ptr<Treap<int>>> results;
+                auto l = std::make_unique<Treap<int>>(), r = std::make_unique<Treap<int>>();
+                src[0]->split(key, *l, *r);
+                results[left] = std::move(l);
+                results[right] = std::move(r);
+                return results;
+            });
+            break;
+        }
+        case Op::Join: {
+            std::string lower = in.getName(), upper = in.getName(), result = in.getName();
+            rebuild(id, { lower, upper }, { result }, [&](std::vector<std::unique_ptr<Treap<int>>>& src) {
+                std::map<std::string, std::unique_ptr<Treap<int>>> results;
+                auto joined = std::make_unique<Treap<int>>();
+                joined->join(*src[0], *src[1]);
+                results[result] = std::move(joined);
+                return results;
+            });
+            break;
+        }
+        default:
+            reply(id, Status::BadRequest, "unknown operation " + std::to_string(frame.code));
+        }
+    }
+
+    // Split y join: se reservan los nombres, se esperan las tareas pendientes de los
+    // orígenes y se opera sobre los treaps ya sin ejecutor. Si la operación falla
+    // (join con rangos solapados), los orígenes vuelven al registro sin cambios.
+    template <typename Fn>
+    void rebuild(uint32_t id, const std::vector<std::string>& sources, const std::vector<std::string>& targets, Fn fn) {
+        std::vector<std::shared_ptr<Executor>> taken;
+        std::string culprit;
+        Status s = registry.reserve(sources, targets, taken, culprit);
+        if (s != Status::Ok) { reply(id, s, culprit); return; }
+
+        std::vector<std::unique_ptr<Treap<int>>> src;
+        for (auto& executor : taken) src.push_back(executor->detach());
+
+        std::vector<std::string> reserved(sources);
+        reserved.insert(reserved.end(), targets.begin(), targets.end());
+        try {
+            registry.publish(reserved, fn(src));
+            reply(id, Status::Ok);
+        } catch (std::exception& ex) {
+            std::map<std::string, std::unique_ptr<Treap<int>>> restored;
+            for (size_t i = 0; i < sources.size(); i++) restored[sources[i]] = std::move(src[i]);
+            registry.publish(reserved, std::move(restored));
+            reply(id, Status::Invalid, ex.what());
+        }
+    }
+};
+
+// --- SERVIDOR ---
+static std::atomic<bool> stopRequested{false};
+
+static void onSignal(int) { stopRequested = true; }
+
+// Deja libre la ruta del socket sin pisar a otro treapd: si alguien acepta la
+// conexión se rechaza el arranque, y solo se borra un socket abandonado por un
+// proceso que terminó sin limpiar (conexión rechazada)
+static bool claimSocketPath(const sockaddr_un& addr, const std::string& path) {
+    int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) return false;
+    int rc = ::connect(probe, reinterpret_cast<const sockaddr*>(&addr), sizeof addr);
+    int err = errno;
+    ::close(probe);
+    if (rc == 0) { std::cerr << "Ya hay un treapd escuchando en " << path << "\n"; return false; }
+    if (err != ECONNREFUSED && err != ENOENT) {
+        std::cerr << "No se pudo comprobar " << path << ": " << std::strerror(err) << "\n";
+        return false;
+    }
+
+    struct stat st;
+    if (::lstat(path.c_str(), &st) != 0) return errno == ENOENT;
+    if (!S_ISSOCK(st.st_mode)) { std::cerr << path << " existe y no es un socket\n"; return false; }
+    return ::unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+int main(int argc, char** argv) {
+    std::string path = DEFAULT_SOCKET;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) path = argv[++i];
+        else { std::cerr << "Uso: treapd [--socket ruta]\n"; return 1; }
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) { std::cerr << "Ruta de socket demasiado larga\n"; return 1; }
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+
+    if (!claimSocketPath(addr, path)) return 1;
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0 || ::listen(listenFd, 64) != 0) {
+        std::cerr << "No se pudo escuchar en " << path << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::cout << "treapd escuchando en " << path << std::endl;
+
+    Registry registry;
+    std::atomic<int> active{0};
+    std::mutex clientsMutex;
+    std::vector<int> clients; // para cortar las conexiones al detenerse
+
+    while (!stopRequested) {
+        pollfd p{ listenFd, POLLIN, 0 };
+        if (::poll(&p, 1, 200) <= 0) continue;
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            clients.push_back(fd);
+        }
+        auto conn = std::make_shared<Connection>(fd, registry, active);
+        std::thread([conn, fd, &clientsMutex, &clients]() mutable {
+            conn->readLoop();
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                clients.erase(std::find(clients.begin(), clients.end(), fd));
+            }
+            conn.reset(); // la conexión vive hasta que respondan sus tareas pendientes
+        }).detach();
+    }
+
+    std::cout << "Deteniendo treapd..." << std::endl;
+    ::close(listenFd);
+    ::unlink(path.c_str());
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (int fd : clients) ::shutdown(fd, SHUT_RDWR);
+    }
+    while (active > 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    registry.clear();
+    return 0;
+}
@@ -0,0 +1,19 @@
+TEMPLATE = app
+TARGET = treapd
+
+CONFIG += console c++17
+CONFIG -= app_bundle qt
+
+INCLUDEPATH += ..
+
+unix: LIBS += -lpthread
+
+SOURCES += \
+    treapd.cpp
+
+HEADERS += \
+    ../treap.h \
+    ../treapcore.h \
+    ../stringkey.h \
+    ../treapreclaimer.h \
+    ../treapservice.h
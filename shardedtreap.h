@@ -0,0 +1,281 @@
+#ifndef SHARDEDTREAP_H
+#define SHARDEDTREAP_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include "treap.h"
+
+// Cola lock-free de un productor y un consumidor (anillo de tamaño potencia de 2)
+template <typename T>
+class SpscQueue {
+    std::vector<T> buffer;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head{0}; // siguiente a leer (consumidor)
+    alignas(64) std::atomic<size_t> tail{0}; // siguiente a escribir (productor)
+
+public:
+    explicit SpscQueue(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        buffer.resize(cap);
+        mask = cap - 1;
+    }
+
+    bool push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) return false; // llena
+        buffer[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false; // vacía
+        value = buffer[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// Contenedor particionado por rangos de clave: N treaps independientes, cada uno
+// con su hilo trabajador. Las operaciones se envían por lotes desde un único hilo
+// (el que llama); cada lote se reparte por shard y se espera a que terminen.
+//
+// El reparto del lote (buscar el shard de cada clave y copiarla a su tarea) corre
+// en serie en el hilo que llama, O(m log N) por lote de m claves. Los trabajadores
+// escalan con los núcleos, pero el rendimiento total queda acotado por ese reparto:
+// con muchos shards el cuello de botella es quien llama, no los treaps.
+//
+// El shard i guarda las claves en (splitters[i-1], splitters[i]].
+template <typename TK>
+class ShardedTreap {
+public:
+    enum class Op { Insert, Search, Remove };
+
+private:
+    struct Task {
+        Op op;
+        std::vector<TK> keys;
+        std::vector<size_t> slots;   // posición de cada clave en el lote original
+        std::vector<char>* results;
+        std::atomic<size_t>* pending;
+    };
+
+    struct Shard {
+        Treap<TK> treap;
+        size_t size = 0; // solo lo toca el trabajador mientras hay tareas
+        SpscQueue<Task*> queue{1024};
+        std::thread worker;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<TK> splitters;
+    std::atomic<bool> stopping{false};
+    double imbalanceFactor;
+    size_t rebalances = 0;
+
+    static void run(Shard* shard, Task* task) {
+        for (size_t i = 0; i < task->keys.size(); i++) {
+            const TK& key = task->keys[i];
+            char r = 0;
+            switch (task->op) {
+            case Op::Insert:
+                if (shard->treap.insert(key)) { shard->size++; r = 1; }
+                break;
+            case Op::Search:
+                r = shard->treap.search(key) ? 1 : 0;
+                break;
+            case Op::Remove:
+                if (shard->treap.remove(key)) { shard->size--; r = 1; }
+                break;
+            }
+            if (task->results) (*task->results)[task->slots[i]] = r;
+        }
+        task->pending->fetch_sub(1, std::memory_order_release);
+    }
+
+    void workerLoop(Shard* shard) {
+        int idle = 0;
+        Task* task = nullptr;
+        while (true) {
+            if (shard->queue.pop(task)) { run(shard, task); idle = 0; continue; }
+            if (stopping.load(std::memory_order_acquire)) break;
+            // Espera activa corta y luego cede la CPU para no quemarla en reposo
+            if (++idle < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    size_t shardOf(const TK& key) const {
+        return std::lower_bound(splitters.begin(), splitters.end(), key) - splitters.begin();
+    }
+
+    void dispatch(Op op, const std::vector<TK>& keys, std::vector<char>* results) {
+        std::vector<Task> tasks(shards.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            Task& t = tasks[shardOf(keys[i])];
+            t.keys.push_back(keys[i]);
+            t.slots.push_back(i);
+        }
+
+        std::atomic<size_t> pending{0};
+        for (auto& t : tasks) if (!t.keys.empty()) pending++;
+
+        for (size_t s = 0; s < shards.size(); s++) {
+            Task& t = tasks[s];
+            if (t.keys.empty()) continue;
+            t.op = op;
+            t.results = results;
+            t.pending = &pending;
+            while (!shards[s]->queue.push(&t)) std::this_thread::yield();
+        }
+
+        while (pending.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    }
+
+    // Traslada todos los nodos de src a dst (vacío) sin copiarlos
+    static void moveInto(Treap<TK>& dst, Treap<TK>& src) {
+        Treap<TK> empty;
+        dst.join(src, empty);
+    }
+
+    // Clave en la posición c (desde 1) contando desde el extremo menor o el mayor.
+    // Recorrido en orden parcial: O(c + log n), proporcional a lo que se va a mover.
+    static TK keyAt(const Treap<TK>& treap, size_t c, bool fromLargest) {
+        std::vector<TreapNode<TK>*> stack;
+        TreapNode<TK>* node = treap.getRoot();
+        while (node != nullptr || !stack.empty()) {
+            while (node != nullptr) { stack.push_back(node); node = fromLargest ? node->right : node->left; }
+            node = stack.back(); stack.pop_back();
+            if (--c == 0) return TK(node->key);
+            node = fromLargest ? node->left : node->right;
+        }
+        throw std::out_of_range("ShardedTreap: rank out of range");
+    }
+
+    // Pasa las 'count' claves mayores del shard i al comienzo del shard i+1
+    void shiftRight(size_t i, size_t count) {
+        Shard& from = *shards[i];
+        Shard& to = *shards[i + 1];
+        TK keep = keyAt(from.treap, count + 1, true); // mayor clave que se queda
+        Treap<TK> low, high, merged;
+        from.treap.split(keep, low, high);
+        moveInto(from.treap, low);
+        merged.join(high, to.treap);
+        moveInto(to.treap, merged);
+        from.size -= count;
+        to.size += count;
+        splitters[i] = keep;
+    }
+
+    // Pasa las 'count' claves menores del shard i+1 al final del shard i
+    void shiftLeft(size_t i, size_t count) {
+        Shard& to = *shards[i];
+        Shard& from = *shards[i + 1];
+        TK last = keyAt(from.treap, count, false); // mayor clave que se mueve
+        Treap<TK> low, high, merged;
+        from.treap.split(last, low, high);
+        moveInto(from.treap, high);
+        merged.join(to.treap, low);
+        moveInto(to.treap, merged);
+        from.size -= count;
+        to.size += count;
+        splitters[i] = last;
+    }
+
+    // Lleva cada shard a total/n claves moviendo solo el excedente entre vecinos:
+    // por cada frontera, un split y un join. El flujo por la frontera i es lo que
+    // sobra (o falta) a la izquierda de ella; los flujos hacia la derecha se aplican
+    // de izquierda a derecha y los de hacia la izquierda al revés, así cada shard ya
+    // recibió lo que le llega antes de tener que ceder. Costo O(movidas + N log n).
+    // Solo se llama con los trabajadores ociosos (después de dispatch).
+    void rebalance() {
+        size_t total = size();
+        size_t n = shards.size();
+
+        // flow[i] > 0: el shard i cede flow[i] claves al i+1; < 0: las recibe
+        std::vector<long long> flow(n - 1);
+        size_t prefix = 0;
+        for (size_t i = 0; i + 1 < n; i++) {
+            prefix += shards[i]->size;
+            flow[i] = (long long)prefix - (long long)((i + 1) * total / n);
+        }
+
+        for (size_t i = 0; i + 1 < n; i++)
+            if (flow[i] > 0) shiftRight(i, size_t(flow[i]));
+        for (size_t i = n - 1; i-- > 0;)
+            if (flow[i] < 0) shiftLeft(i, size_t(-flow[i]));
+
+        rebalances++;
+    }
+
+    void rebalanceIfNeeded() {
+        if (shards.size() < 2) return;
+        size_t total = 0, largest = 0;
+        for (auto& s : shards) { total += s->size; largest = std::max(largest, s->size); }
+        double mean = double(total) / shards.size();
+        if (total < shards.size() * 64 || largest <= mean * imbalanceFactor) return;
+        rebalance();
+    }
+
+public:
+    // 'initialSplitters' debe estar ordenado; define shards = splitters + 1
+    explicit ShardedTreap(const std::vector<TK>& initialSplitters, double imbalance = 1.5)
+        : splitters(initialSplitters), imbalanceFactor(imbalance) {
+        if (!std::is_sorted(splitters.begin(), splitters.end()))
+            throw std::invalid_argument("ShardedTreap: splitters must be sorted");
+        for (size_t i = 0; i <= splitters.size(); i++) shards.push_back(std::make_unique<Shard>());
+        for (auto& s : shards) {
+            Shard* raw = s.get();
+            raw->worker = std::thread([this, raw] { workerLoop(raw); });
+        }
+    }
+
+    ~ShardedTreap() {
+        stopping.store(true, std::memory_order_release);
+        for (auto& s : shards) s->worker.join();
+    }
+
+    ShardedTreap(const ShardedTreap&) = delete;
+    ShardedTreap& operator=(const ShardedTreap&) = delete;
+
+    // Devuelve cuántas claves se insertaron (las repetidas se ignoran)
+    size_t insertBatch(const std::vector<TK>& keys) {
+        std::vector<char> results(keys.size(), 0);
+        dispatch(Op::Insert, keys, &results);
+        rebalanceIfNeeded();
+        return std::count(results.begin(), results.end(), 1);
+    }
+
+    std::vector<char> searchBatch(const std::vector<TK>& keys) {
+        std::vector<char> results(keys.size(), 0);
+        dispatch(Op::Search, keys, &results);
+        return results;
+    }
+
+    size_t removeBatch(const std::vector<TK>& keys) {
+        std::vector<char> results(keys.size(), 0);
+        dispatch(Op::Remove, keys, &results);
+        rebalanceIfNeeded();
+        return std::count(results.begin(), results.end(), 1);
+    }
+
+    size_t shardCount() const { return shards.size(); }
+    size_t shardSize(size_t i) const { return shards[i]->size; }
+    size_t rebalanceCount() const { return rebalances; }
+    const std::vector<TK>& getSplitters() const { return splitters; }
+
+    size_t size() const {
+        size_t total = 0;
+        for (auto& s : shards) total += s->size;
+        return total;
+    }
+};
+
+#endif // SHARDEDTREAP_H
@@ -0,0 +1,148 @@
+#ifndef STRINGKEY_H
+#define STRINGKEY_H
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <string>
+#include <mutex>
+#include <new>
+#include <algorithm>
+#include <stdexcept>
+
+// --- CLAVES std::string PARA Treap ---
+// TreapNode<std::string> no guarda un std::string: guarda los primeros 8 bytes
+// como un entero big-endian (comparar dos prefijos es una sola comparación de
+// enteros) y el resto de la cadena fuera de línea, en un arena compartido con
+// los nodos. Solo se leen los bytes del resto cuando los prefijos empatan.
+// Con claves que comparten un prefijo largo (rutas, "usuarios/<id>/...") los 8
+// bytes siempre empatan y la comparación paga el entero más el memcmp: ahí inserta
+// hasta ~20% más lento que un nodo con std::string ('treap_bench strings').
+
+// Arena de bloques pequeños para los nodos y los restos de las claves.
+// Reparte trozos de 64 KB en orden, así un nodo y su resto quedan contiguos;
+// los bloques liberados vuelven a listas por tamaño (no al sistema).
+class StringArena {
+public:
+    static constexpr size_t ALIGN = 8;
+    static constexpr size_t MAX_SMALL = 256;     // bloques mayores van a ::operator new
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    // Único y nunca destruido: los nodos pasan de un treap a otro con split/join
+    // y pueden liberarse durante la destrucción de objetos estáticos
+    static StringArena& instance() {
+        static StringArena* arena = new StringArena();
+        return *arena;
+    }
+
+    void* allocate(size_t size) {
+        size = roundUp(size);
+        if (size > MAX_SMALL) return ::operator new(size);
+        std::lock_guard<std::mutex> lock(mutex);
+        FreeBlock*& head = freeLists[size / ALIGN];
+        if (head != nullptr) {
+            FreeBlock* block = head;
+            head = block->next;
+            return block;
+        }
+        if (size_t(end - cur) < size) {
+            cur = static_cast<char*>(::operator new(CHUNK_SIZE));
+            end = cur + CHUNK_SIZE;
+        }
+        void* p = cur;
+        cur += size;
+        return p;
+    }
+
+    void deallocate(void* p, size_t size) {
+        if (p == nullptr) return;
+        size = roundUp(size);
+        if (size > MAX_SMALL) { ::operator delete(p); return; }
+        std::lock_guard<std::mutex> lock(mutex);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeLists[size / ALIGN];
+        freeLists[size / ALIGN] = block;
+    }
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+
+    std::mutex mutex;
+    FreeBlock* freeLists[MAX_SMALL / ALIGN + 1] = {};
+    char* cur = nullptr;
+    char* end = nullptr;
+
+    StringArena() = default;
+    static size_t roundUp(size_t size) { return (std::max(size, sizeof(FreeBlock)) + ALIGN - 1) & ~(ALIGN - 1); }
+};
+
+// Clave comparable en dos partes. Construida desde un std::string es solo una
+// vista (el resto apunta a la cadena original); los nodos copian el resto al arena.
+struct StringKey {
+    static constexpr uint32_t PREFIX = 8;
+
+    uint64_t prefix = 0;        // bytes [0, 8) en big-endian, rellenos con ceros
+    const char* tail = nullptr; // bytes [8, length), o nullptr si length <= 8
+    uint32_t length = 0;
+
+    StringKey() = default;
+    StringKey(const std::string& s) : StringKey(s.data(), s.size()) {}
+    StringKey(const char* data, size_t size) {
+        if (size > UINT32_MAX) throw std::length_error("StringKey: key too long");
+        length = uint32_t(size);
+        for (uint32_t i = 0; i < PREFIX; i++)
+            prefix = (prefix << 8) | (i < length ? uint8_t(data[i]) : 0);
+        if (length > PREFIX) tail = data + PREFIX;
+    }
+
+    explicit operator std::string() const {
+        std::string s(length, '\0');
+        for (uint32_t i = 0; i < std::min(length, PREFIX); i++)
+            s[i] = char(prefix >> (8 * (PREFIX - 1 - i)));
+        if (length > PREFIX) std::memcpy(&s[PREFIX], tail, length - PREFIX);
+        return s;
+    }
+
+    // Mismo orden que std::string (bytes sin signo, luego longitud)
+    friend bool operator<(const StringKey& a, const StringKey& b) {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix;
+        if (a.length <= PREFIX || b.length <= PREFIX) return a.length < b.length;
+        int c = std::memcmp(a.tail, b.tail, std::min(a.length, b.length) - PREFIX);
+        return c != 0 ? c < 0 : a.length < b.length;
+    }
+};
+
+template <typename TK>
+struct TreapNode;
+
+template <>
+struct TreapNode<std::string> {
+    typedef StringKey key_type;
+
+    StringKey key;
+    int priority;
+    TreapNode* left;
+    TreapNode* right;
+
+    TreapNode(const StringKey& key_, const int& priority_)
+        : key(key_), priority(priority_), left(nullptr), right(nullptr) {
+        if (key.length > StringKey::PREFIX) {
+            char* tail = static_cast<char*>(StringArena::instance().allocate(key.length - StringKey::PREFIX));
+            std::memcpy(tail, key_.tail, key.length - StringKey::PREFIX);
+            key.tail = tail;
+        }
+    }
+
+    ~TreapNode() {
+        if (key.length > StringKey::PREFIX)
+            StringArena::instance().deallocate(const_cast<char*>(key.tail), key.length - StringKey::PREFIX);
+    }
+
+    TreapNode(const TreapNode&) = delete;
+    TreapNode& operator=(const TreapNode&) = delete;
+
+    static void* operator new(size_t size) { return StringArena::instance().allocate(size); }
+    static void operator delete(void* p, size_t size) { StringArena::instance().deallocate(p, size); }
+};
+
+#endif // STRINGKEY_H
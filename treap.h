@@ -5,9 +5,17 @@
 #include <stdexcept>
 #include <algorithm>
 #include <limits>
+#include <vector>
+#include <cstdint>
+#include "stringkey.h"
+#include "treapcore.h"
+#include "treapreclaimer.h"
 
+// Nodo genérico; stringkey.h especializa el de std::string
 template <typename TK>
 struct TreapNode {
+    typedef TK key_type;
+
     TK key;
     int priority;
     TreapNode* left;
@@ -25,75 +33,180 @@ public:
 
 private:
     typedef TreapNode<TK> Node;
+    typedef TreapCore<Node> Core;
+    // Forma de la clave guardada en el nodo (TK salvo especializaciones); las
+    // operaciones públicas convierten la clave una sola vez al entrar
+    typedef typename Node::key_type Key;
     Node* root;
     std::mt19937 rng;
     std::uniform_int_distribution<int> dist;
 
-    void rotateLeft(Node*& node) {
-        Node* temp = node->right;
-        node->right = temp->left;
-        temp->left = node;
-        node = temp;
+    // Espinazo derecho cacheado (raíz -> máximo) para fingerInsert/fingerSearch.
+    // Cualquier otra operación que modifique el árbol lo invalida.
+    std::vector<Node*> spine;
+    bool spineValid = false;
+
+    void rebuildSpine() {
+        spine.clear();
+        for (Node* n = root; n != nullptr; n = n->right) spine.push_back(n);
+        spineValid = true;
     }
 
-    void rotateRight(Node*& node) {
-        Node* temp = node->left;
-        node->left = temp->right;
-        temp->right = node;
-        node = temp;
+    // Primera posición del espinazo con clave >= key, buscando desde el máximo: O(log d)
+    size_t spinePosition(const Key& key) {
+        if (!spineValid) rebuildSpine();
+        size_t j = spine.size();
+        while (j > 0 && key < spine[j - 1]->key) j--;
+        if (j > 0 && !(spine[j - 1]->key < key)) j--; // clave igual
+        return j;
     }
 
-    void insert(Node*& node, const TK& key, const int& priority) {
-        if (node == nullptr)
+    Node*& spineLink(size_t i) { return i == 0 ? root : spine[i - 1]->right; }
+
+    // Devuelve false si la clave ya estaba (el árbol no cambia)
+    bool insert(Node*& node, const Key& key, const int& priority) {
+        if (node == nullptr) {
             node = new Node(key, priority);
-        else if (key < node->key) {
-            insert(node->left, key, priority);
+            return true;
+        }
+        if (key < node->key) {
+            if (!insert(node->left, key, priority)) return false;
             if (node->left->priority > node->priority)
-                rotateRight(node);
+                Core::rotateRight(node);
+            return true;
         }
-        else if (node->key < key) {
-            insert(node->right, key, priority);
+        if (node->key < key) {
+            if (!insert(node->right, key, priority)) return false;
             if (node->right->priority > node->priority)
-                rotateLeft(node);
+                Core::rotateLeft(node);
+            return true;
         }
+        return false;
     }
 
-    void recTreapDelete(Node*& node, const TK& key) {
-        if (node == nullptr) return;
-        if (key < node->key) recTreapDelete(node->left, key);
-        else if (node->key < key) recTreapDelete(node->right, key);
-        else rootDelete(node);
-    }
-
-    void rootDelete(Node*& node) {
-        if (!node->left && !node->right) { delete node; node = nullptr; return; }
-        if (!node->left) { rotateLeft(node); rootDelete(node->left); return; }
-        if (!node->right) { rotateRight(node); rootDelete(node->right); return; }
-
-        if (node->left->priority > node->right->priority) {
-            rotateRight(node); rootDelete(node->right);
-        } else {
-            rotateLeft(node); rootDelete(node->left);
-        }
+    // Devuelve false si la clave no estaba
+    bool recTreapDelete(Node*& node, const Key& key) {
+        if (node == nullptr) return false;
+        if (key < node->key) return recTreapDelete(node->left, key);
+        if (node->key < key) return recTreapDelete(node->right, key);
+        Core::rootDelete(node);
+        return true;
     }
 
-    void insert_allow_duplicate(Node*& node, const TK& key, const int& priority) {
+    void insert_allow_duplicate(Node*& node, const Key& key, const int& priority) {
         if (node == nullptr) { node = new Node(key, priority); return; }
         if (key < node->key) {
             insert_allow_duplicate(node->left, key, priority);
-            if (node->left->priority > node->priority) rotateRight(node);
+            if (node->left->priority > node->priority) Core::rotateRight(node);
         } else {
             insert_allow_duplicate(node->right, key, priority);
-            if (node->right->priority > node->priority) rotateLeft(node);
+            if (node->right->priority > node->priority) Core::rotateLeft(node);
         }
     }
 
-    void clear(Node*& node) {
+    // Divide 'node' en claves menores (l) y mayores (r) que key, sin rotaciones.
+    // Si hay un nodo con la clave, queda suelto en 'eq'.
+    void splitNode(Node* node, const Key& key, Node*& l, Node*& r, Node*& eq) {
+        if (node == nullptr) { l = r = nullptr; return; }
+        if (node->key < key) { splitNode(node->right, key, node->right, r, eq); l = node; }
+        else if (key < node->key) { splitNode(node->left, key, l, node->left, eq); r = node; }
+        else {
+            l = node->left; r = node->right;
+            node->left = node->right = nullptr;
+            eq = node;
+        }
+    }
+
+    // l: claves < key (o <= key si 'inclusive'), r: el resto. Sin rotaciones.
+    static void splitAt(Node* node, const Key& key, bool inclusive, Node*& l, Node*& r) {
+        if (node == nullptr) { l = r = nullptr; return; }
+        bool toLeft = inclusive ? !(key < node->key) : node->key < key;
+        if (toLeft) { splitAt(node->right, key, inclusive, node->right, r); l = node; }
+        else { splitAt(node->left, key, inclusive, l, node->left); r = node; }
+    }
+
+    // Entrega el subárbol al hilo de fondo (un nodo suelto se borra aquí mismo)
+    static void reclaim(Node* node) {
         if (node == nullptr) return;
-        clear(node->left);
-        clear(node->right);
+        if (!node->left && !node->right) { delete node; return; }
+        TreapReclaimer::instance().post([node] { Core::freeSubtree(node); });
+    }
+
+    // Primera clave del lote [first, last) que no es menor que la del nodo
+    static const TK* lowerBound(const TK* first, const TK* last, const Key& key) {
+        return std::lower_bound(first, last, key, [](const TK& k, const Key& nodeKey) { return Key(k) < nodeKey; });
+    }
+
+    // Agrega al subárbol las claves de [first, last) (ordenadas y sin repetir). Cada
+    // nodo reparte el lote con una búsqueda binaria y solo se baja a los hijos que
+    // reciben claves; en un hueco vacío el resto del lote se arma en O(k), y una
+    // clave sola sigue por insert(). Si una clave nueva supera la prioridad del nodo,
+    // se reengancha con merge. Solo se crean nodos para las claves que faltaban;
+    // 'added' cuenta cuántas fueron.
+    Node* unionSorted(Node* node, const TK* first, const TK* last, size_t& added) {
+        if (first == last) return node;
+        if (last - first == 1) { added += insert(node, Key(*first), dist(rng)); return node; }
+        if (node == nullptr) { added += size_t(last - first); return buildSorted(first, last); }
+        const TK* split = lowerBound(first, last, node->key);
+        bool found = split != last && !(node->key < Key(*split));
+        Node* l = unionSorted(node->left, first, split, added);
+        Node* r = unionSorted(node->right, found ? split + 1 : split, last, added);
+        if ((!l || l->priority <= node->priority) && (!r || r->priority <= node->priority)) {
+            node->left = l;
+            node->right = r;
+            return node;
+        }
+        node->left = node->right = nullptr;
+        return Core::mergeNodes(Core::mergeNodes(l, node), r);
+    }
+
+    // Quita del subárbol las claves de [first, last) (ordenadas y sin repetir) sin
+    // reservar memoria, con el mismo reparto del lote que unionSorted.
+    Node* differenceSorted(Node* node, const TK* first, const TK* last, size_t& removed) {
+        if (node == nullptr || first == last) return node;
+        if (last - first == 1) { removed += recTreapDelete(node, Key(*first)); return node; }
+        const TK* split = lowerBound(first, last, node->key);
+        bool found = split != last && !(node->key < Key(*split));
+        node->left = differenceSorted(node->left, first, split, removed);
+        node->right = differenceSorted(node->right, found ? split + 1 : split, last, removed);
+        if (!found) return node;
+        Node* merged = Core::mergeNodes(node->left, node->right);
         delete node;
-        node = nullptr;
+        removed++;
+        return merged;
+    }
+
+    // Construye un treap en O(m) a partir de claves ordenadas y sin repetir
+    Node* buildSorted(const TK* first, const TK* last) {
+        std::vector<Node*> stack; // espinazo derecho del árbol en construcción
+        for (const TK* key = first; key != last; ++key) {
+            Node* node = new Node(*key, dist(rng));
+            Node* lastPopped = nullptr;
+            while (!stack.empty() && stack.back()->priority < node->priority) {
+                lastPopped = stack.back();
+                stack.pop_back();
+            }
+            node->left = lastPopped;
+            if (!stack.empty()) stack.back()->right = node;
+            stack.push_back(node);
+        }
+        return stack.empty() ? nullptr : stack.front();
+    }
+
+    static void sortUnique(std::vector<TK>& keys) {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end(),
+                               [](const TK& a, const TK& b) { return !(a < b) && !(b < a); }),
+                   keys.end());
+    }
+
+    // Recorrido en orden que solo baja a los subárboles que pueden tener claves en [lo, hi]
+    void collectRange(Node* node, const Key& lo, const Key& hi, std::vector<TK>& out, size_t limit) const {
+        if (node == nullptr || out.size() >= limit) return;
+        if (lo < node->key) collectRange(node->left, lo, hi, out, limit);
+        if (out.size() >= limit) return;
+        if (!(node->key < lo) && !(hi < node->key)) out.push_back(TK(node->key));
+        if (node->key < hi) collectRange(node->right, lo, hi, out, limit);
     }
 
     int height(Node* const& node) const {
@@ -109,9 +222,10 @@ private:
 
 public:
     Treap() : root(nullptr), rng(std::random_device{}()), dist(1, 1000000) {}
-    ~Treap() { clear(root); }
+    ~Treap() { Core::clear(root); }
 
-    bool search(const TK& key) const {
+    bool search(const TK& k) const {
+        const Key& key = k; // para std::string: prefijo calculado una vez, no en cada nivel
         Node* current = root;
         while (current != nullptr) {
             if (key < current->key) current = current->left;
@@ -121,13 +235,130 @@ public:
         return false;
     }
 
-    void insert(const TK &key) { insert(root, key, dist(rng)); }
-    void insert(const TK& key, const int& priority) { insert(root, key, priority); }
-    void remove(const TK& key) { recTreapDelete(root, key); }
+    // Agrega a 'out' las claves en [lo, hi] en orden, como máximo 'limit'; devuelve cuántas agregó
+    size_t range(const TK& lo, const TK& hi, std::vector<TK>& out, size_t limit = SIZE_MAX) const {
+        size_t before = out.size();
+        collectRange(root, lo, hi, out, before + std::min(limit, SIZE_MAX - before));
+        return out.size() - before;
+    }
+
+    // Prioridad aleatoria que usaría insert(key); permite registrarla y luego insertar con ella
+    int nextPriority() { return dist(rng); }
+    // Fija la secuencia de prioridades aleatorias (reproducción de trazas)
+    void seedPriorities(unsigned seed) { rng.seed(seed); dist.reset(); }
+
+    // Un solo descenso: devuelven true si el árbol cambió (clave nueva / clave quitada)
+    bool insert(const TK& key) { return insert(key, dist(rng)); }
+    bool insert(const TK& k, const int& priority) {
+        const Key& key = k;
+        if (!insert(root, key, priority)) return false;
+        spineValid = false;
+        return true;
+    }
+    bool remove(const TK& k) {
+        const Key& key = k;
+        if (!recTreapDelete(root, key)) return false;
+        spineValid = false;
+        return true;
+    }
+
+    // Inserción desde el máximo (claves casi ordenadas): cuesta O(log d) según la
+    // distancia d al máximo en lugar de O(log n), y agregar un nuevo máximo es O(1) amortizado
+    void fingerInsert(const TK& key) { fingerInsert(key, dist(rng)); }
+    void fingerInsert(const TK& k, const int& priority) {
+        const Key& key = k;
+        size_t j = spinePosition(key);
+
+        if (j == spine.size()) {
+            // Nuevo máximo: como al construir un árbol cartesiano, los nodos del espinazo
+            // con menor prioridad pasan a ser su subárbol izquierdo
+            Node* node = new Node(key, priority);
+            Node* last = nullptr;
+            while (!spine.empty() && spine.back()->priority < priority) {
+                last = spine.back();
+                spine.pop_back();
+            }
+            node->left = last;
+            spineLink(spine.size()) = node;
+            spine.push_back(node);
+            return;
+        }
+        if (!(key < spine[j]->key)) return; // ya existe
+
+        // La clave va en el subárbol izquierdo de spine[j]; si sube por prioridad,
+        // se sigue rotando hacia arriba a lo largo del espinazo
+        Node* anchor = spine[j];
+        if (!insert(spineLink(j), key, priority)) return; // ya existía dentro del subárbol
+        size_t i = j;
+        while (i > 0 && spine[i - 1]->right->priority > spine[i - 1]->priority) {
+            Core::rotateLeft(spineLink(i - 1));
+            i--;
+        }
+
+        // Solo cambia el tramo del espinazo entre la posición i y 'anchor'
+        std::vector<Node*> chain;
+        for (Node* n = spineLink(i); n != anchor; n = n->right) chain.push_back(n);
+        spine.erase(spine.begin() + i, spine.begin() + j);
+        spine.insert(spine.begin() + i, chain.begin(), chain.end());
+    }
+
+    // Búsqueda desde el máximo: O(log d). Solo ayuda con claves casi ordenadas en
+    // árboles grandes, y cualquier modificación que no sea fingerInsert obliga a
+    // reconstruir el espinazo.
+    bool fingerSearch(const TK& k) {
+        const Key& key = k;
+        size_t j = spinePosition(key);
+        if (j == spine.size()) return false;
+        if (!(key < spine[j]->key)) return true; // la clave está en el espinazo
+        // Está entre spine[j-1] y spine[j]: solo puede estar a la izquierda de spine[j]
+        Node* current = spine[j]->left;
+        while (current != nullptr) {
+            if (key < current->key) current = current->left;
+            else if (current->key < key) current = current->right;
+            else return true;
+        }
+        return false;
+    }
+
+    // Inserción por lotes: ordena el lote y lo reparte recursivamente sobre el árbol
+    // en O(m log(n/m + 1)); solo reserva los nodos que agrega. Devuelve cuántos fueron.
+    size_t insertBatch(std::vector<TK> keys) {
+        sortUnique(keys);
+        size_t added = 0;
+        root = unionSorted(root, keys.data(), keys.data() + keys.size(), added);
+        if (added) spineValid = false;
+        return added;
+    }
+
+    // Eliminación por lotes sin reservar memoria. Devuelve cuántas claves se quitaron.
+    size_t eraseBatch(std::vector<TK> keys) {
+        sortUnique(keys);
+        size_t removed = 0;
+        root = differenceSorted(root, keys.data(), keys.data() + keys.size(), removed);
+        if (removed) spineValid = false;
+        return removed;
+    }
+
+    // Quita todas las claves en [lo, hi] con dos splits y un merge, en O(log n).
+    // Los nodos quitados se liberan en segundo plano (TreapReclaimer).
+    // Devuelve false si no había claves en el rango.
+    bool eraseRange(const TK& lo, const TK& hi) {
+        const Key& l = lo;
+        const Key& h = hi;
+        if (h < l) return false;
+        spineValid = false;
+        Node *left, *rest, *mid, *right;
+        splitAt(root, l, false, left, rest);
+        splitAt(rest, h, true, mid, right);
+        root = Core::mergeNodes(left, right);
+        reclaim(mid);
+        return mid != nullptr;
+    }
 
     void split(const TK& key, Treap& T1, Treap& T2) {
         if (&T1 == this || &T2 == this) throw std::invalid_argument("Invalid treap references");
         if (T1.root != nullptr || T2.root != nullptr) throw std::invalid_argument("Target treaps must be empty");
+        spineValid = T1.spineValid = T2.spineValid = false;
 
         insert_allow_duplicate(root, key, INF_PRIORITY);
         T1.root = this->root->left;
@@ -138,6 +369,7 @@ public:
 
     void join(Treap& T1, Treap& T2) {
         if (this->root != nullptr) throw std::runtime_error("Join target must be empty");
+        spineValid = T1.spineValid = T2.spineValid = false;
 
         // FIX: Manejo de vacíos para evitar crash
         if (T1.root == nullptr) { this->root = T2.root; T2.root = nullptr; return; }
@@ -153,25 +385,27 @@ public:
         T2.root = nullptr;
 
         this->root = sentinel;
-        rootDelete(root);
+        Core::rootDelete(root);
     }
 
     TK maxKey() const {
         if (root == nullptr) throw std::runtime_error("maxKey(): empty treap");
-        Node* current = root;
-        while (current->right != nullptr) current = current->right;
-        return current->key;
+        return TK(Core::maxNode(root)->key);
     }
 
     TK minKey() const {
         if (root == nullptr) throw std::runtime_error("minKey(): empty treap");
-        Node* current = root;
-        while (current->left != nullptr) current = current->left;
-        return current->key;
+        return TK(Core::minNode(root)->key);
     }
 
     int height() const { return height(root); }
-    void clear() { clear(root); }
+    void clear() { spineValid = false; Core::clear(root); }
+    // Vacía el treap al instante; los nodos se liberan en segundo plano
+    void clearDeferred() {
+        spineValid = false;
+        reclaim(root);
+        root = nullptr;
+    }
     bool empty() const { return root == nullptr; }
     bool check_properties() const { return check_properties(root).valid; }
     Node* getRoot() const { return root; }
@@ -0,0 +1,102 @@
+#ifndef TREAPCORE_H
+#define TREAPCORE_H
+
+// Algoritmos de nodo comunes a Treap, TreapMap y TreapMultiset.
+//
+// 'Node' necesita key, priority, left y right. 'Update' recalcula lo que el nodo
+// guarda de su subárbol (agregados, contadores) a partir de sus hijos:
+//     static void pull(Node* node);
+// Se llama de abajo hacia arriba después de cada cambio de hijos. NoUpdate es
+// para nodos que no guardan nada del subárbol.
+struct NoUpdate {
+    template <typename Node>
+    static void pull(Node*) {}
+};
+
+template <typename Node, typename Update = NoUpdate>
+struct TreapCore {
+    static void rotateLeft(Node*& node) {
+        Node* temp = node->right;
+        node->right = temp->left;
+        temp->left = node;
+        Update::pull(node);
+        Update::pull(temp);
+        node = temp;
+    }
+
+    static void rotateRight(Node*& node) {
+        Node* temp = node->left;
+        node->left = temp->right;
+        temp->right = node;
+        Update::pull(node);
+        Update::pull(temp);
+        node = temp;
+    }
+
+    // Baja el nodo rotando hacia el hijo de mayor prioridad hasta que sea hoja y lo borra
+    static void rootDelete(Node*& node) {
+        if (!node->left && !node->right) { delete node; node = nullptr; return; }
+        if (!node->left) { rotateLeft(node); rootDelete(node->left); Update::pull(node); return; }
+        if (!node->right) { rotateRight(node); rootDelete(node->right); Update::pull(node); return; }
+
+        if (node->left->priority > node->right->priority) {
+            rotateRight(node); rootDelete(node->right);
+        } else {
+            rotateLeft(node); rootDelete(node->left);
+        }
+        Update::pull(node);
+    }
+
+    // l: claves <= key, r: claves > key. Sin rotaciones.
+    template <typename K>
+    static void splitNode(Node* node, const K& key, Node*& l, Node*& r) {
+        if (node == nullptr) { l = r = nullptr; return; }
+        if (key < node->key) { splitNode(node->left, key, l, node->left); r = node; }
+        else { splitNode(node->right, key, node->right, r); l = node; }
+        Update::pull(node);
+    }
+
+    // Une dos subárboles donde todas las claves de l son menores que las de r
+    static Node* mergeNodes(Node* l, Node* r) {
+        if (l == nullptr) return r;
+        if (r == nullptr) return l;
+        if (l->priority > r->priority) { l->right = mergeNodes(l->right, r); Update::pull(l); return l; }
+        r->left = mergeNodes(l, r->left);
+        Update::pull(r);
+        return r;
+    }
+
+    // Libera un subárbol sin recursión: rota hacia la derecha hasta que el nodo
+    // actual no tenga hijo izquierdo, lo borra y sigue por su hijo derecho
+    static void freeSubtree(Node* node) {
+        while (node != nullptr) {
+            if (node->left != nullptr) {
+                Node* l = node->left;
+                node->left = l->right;
+                l->right = node;
+                node = l;
+            } else {
+                Node* r = node->right;
+                delete node;
+                node = r;
+            }
+        }
+    }
+
+    static void clear(Node*& node) {
+        freeSubtree(node);
+        node = nullptr;
+    }
+
+    static Node* minNode(Node* node) {
+        while (node->left != nullptr) node = node->left;
+        return node;
+    }
+
+    static Node* maxNode(Node* node) {
+        while (node->right != nullptr) node = node->right;
+        return node;
+    }
+};
+
+#endif // TREAPCORE_H
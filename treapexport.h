@@ -0,0 +1,186 @@
+#ifndef TREAPEXPORT_H
+#define TREAPEXPORT_H
+
+#include <QImage>
+#include <QPainter>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <random>
+#include <cmath>
+#include "treap.h"
+#include "treaplayout.h"
+#include "visualnode.h"
+#include "pngstream.h"
+
+// Exportación sin pantalla de un treap a PNG o SVG.
+// No crea items de QGraphicsScene: recorre el árbol con las mismas reglas de
+// TreapLayout y dibuja directamente. El PNG se genera por franjas horizontales
+// de 'tileSize' filas que se comprimen y escriben al disco al terminar cada una:
+// la imagen ocupa ancho × tileSize × 3 bytes, sin guardarla entera.
+// Cada franja ocupa todo el ancho, y el ancho crece con la cantidad de nodos (las
+// hojas quedan a NODE_SEPARATION px): el único tope es 'maxWidth', que escala el
+// dibujo. Con cientos de miles de nodos la escala cae a centésimas y los nodos no se
+// leen; para árboles así conviene el SVG. El layout guarda una entrada por nodo, así
+// que la memoria total sigue siendo O(n) en nodos.
+namespace TreapExport {
+
+struct Options {
+    int tileSize = 256;      // alto de cada franja en píxeles
+    int maxWidth = 32768;    // ancho máximo de la imagen (y de cada franja); se escala si hace falta
+};
+
+// Margen de la caja de un nodo respecto a su centro (ver VisualNode::boundingRect)
+constexpr qreal NODE_LEFT = 30, NODE_TOP = 45, NODE_BOTTOM = 25, MARGIN = 20;
+const QPointF ROOT_POS(0, 60);
+
+inline QColor nodeColor() { return QColor(255, 255, 160); }
+
+inline QRectF sceneBounds(const TreapLayout::Tidy<int>& layout) {
+    qreal minX = 0, maxX = 0, maxY = ROOT_POS.y();
+    layout.visit(ROOT_POS, [&](TreapNode<int>*, const QPointF& pos, const QPointF*) {
+        minX = std::min(minX, pos.x());
+        maxX = std::max(maxX, pos.x());
+        maxY = std::max(maxY, pos.y());
+        return true;
+    });
+    return QRectF(QPointF(minX - NODE_LEFT - MARGIN, ROOT_POS.y() - NODE_TOP - MARGIN),
+                  QPointF(maxX + NODE_LEFT + MARGIN, maxY + NODE_BOTTOM + MARGIN));
+}
+
+inline bool exportPng(TreapNode<int>* root, const QString& path, const Options& opt) {
+    TreapLayout::Tidy<int> layout(root);
+    QRectF bounds = sceneBounds(layout);
+    qreal scale = std::min<qreal>(1.0, opt.maxWidth / bounds.width());
+    int width = std::max(1, int(std::ceil(bounds.width() * scale)));
+    int height = std::max(1, int(std::ceil(bounds.height() * scale)));
+    if (scale < 0.5)
+        qWarning().nospace() << "El árbol mide " << qint64(bounds.width()) << " px de ancho; escalado a "
+                             << scale << " para no pasar de --max-width " << opt.maxWidth
+                             << " (los nodos pueden no leerse; el SVG no se escala)";
+
+    PngStreamWriter png;
+    if (!png.open(path, width, height)) return false;
+
+    QImage band(width, opt.tileSize, QImage::Format_RGB888);
+    QPen edgePen(Qt::black, 2);
+
+    for (int top = 0; top < height; top += opt.tileSize) {
+        int rows = std::min(opt.tileSize, height - top);
+        qreal bandTop = bounds.top() + top / scale;
+        qreal bandBottom = bounds.top() + (top + rows) / scale;
+
+        band.fill(Qt::white);
+        QPainter p(&band);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.scale(scale, scale);
+        p.translate(-bounds.left(), -bandTop);
+
+        layout.visit(ROOT_POS, [&](TreapNode<int>* node, const QPointF& pos, const QPointF* parent) {
+            if (parent && pos.y() - 20 >= bandTop && parent->y() + 20 <= bandBottom) {
+                p.setPen(edgePen);
+                p.drawLine(QPointF(parent->x(), parent->y() + 20), QPointF(pos.x(), pos.y() - 20));
+            }
+            if (pos.y() + NODE_BOTTOM >= bandTop && pos.y() - NODE_TOP <= bandBottom) {
+                p.save();
+                p.translate(pos);
+                VisualNode::paintNode(&p, node->key, node->priority, nodeColor(), false);
+                p.restore();
+            }
+            // Los hijos (y sus aristas) empiezan debajo de este nodo
+            return pos.y() + 20 <= bandBottom;
+        });
+        p.end();
+
+        for (int y = 0; y < rows; y++) png.writeRow(band.constScanLine(y));
+    }
+    return png.close();
+}
+
+// El SVG se escribe mientras se recorre el árbol, sin acumular el documento
+inline bool exportSvg(TreapNode<int>* root, const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) return false;
+    QTextStream out(&file);
+    // Notación fija con un decimal: con el modo por defecto (6 cifras significativas)
+    // las coordenadas de un árbol de millones de píxeles se redondean a centenas
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(1);
+
+    TreapLayout::Tidy<int> layout(root);
+    QRectF b = sceneBounds(layout);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << b.width() << "\" height=\"" << b.height()
+        << "\" viewBox=\"" << b.left() << " " << b.top() << " " << b.width() << " " << b.height() << "\">\n"
+        << "<style>line{stroke:#000;stroke-width:2}circle{fill:" << nodeColor().name()
+        << ";stroke:#000;stroke-width:2}text{font-family:sans-serif;text-anchor:middle}"
+        << ".k{font-size:13px;font-weight:bold}.p{font-size:11px;fill:#808080}</style>\n"
+        << "<rect x=\"" << b.left() << "\" y=\"" << b.top() << "\" width=\"" << b.width()
+        << "\" height=\"" << b.height() << "\" fill=\"#fff\"/>\n";
+
+    layout.visit(ROOT_POS, [&](TreapNode<int>* node, const QPointF& pos, const QPointF* parent) {
+        if (parent)
+            out << "<line x1=\"" << parent->x() << "\" y1=\"" << parent->y() + 20
+                << "\" x2=\"" << pos.x() << "\" y2=\"" << pos.y() - 20 << "\"/>\n";
+        out << "<g transform=\"translate(" << pos.x() << "," << pos.y() << ")\"><circle r=\"20\"/>"
+            << "<text class=\"k\" y=\"5\">" << node->key << "</text>"
+            << "<text class=\"p\" y=\"-31\">p:" << node->priority << "</text></g>\n";
+        return true;
+    });
+
+    out << "</svg>\n";
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+// Punto de entrada del modo sin pantalla:
+//   --export archivo.png|archivo.svg [--nodes N] [--seed S] [--tile T] [--max-width W]
+// Genera un treap con N claves aleatorias y lo exporta. El PNG usa franjas de
+// --tile filas a todo el ancho (ancho × tile × 3 bytes de imagen; el layout es O(n))
+// y se escala para no superar --max-width; con cientos de miles de nodos el resultado ya no se lee.
+inline int runFromArguments(const QStringList& args) {
+    QString path;
+    int nodes = 1000;
+    unsigned seed = 1;
+    Options opt;
+
+    for (int i = 1; i < args.size(); i++) {
+        QString next = i + 1 < args.size() ? args[i + 1] : QString();
+        if (args[i] == "--export") { path = next; i++; }
+        else if (args[i] == "--nodes") { nodes = next.toInt(); i++; }
+        else if (args[i] == "--seed") { seed = next.toUInt(); i++; }
+        else if (args[i] == "--tile") { opt.tileSize = std::max(1, next.toInt()); i++; }
+        else if (args[i] == "--max-width") { opt.maxWidth = std::max(1, next.toInt()); i++; }
+    }
+    if (path.isEmpty()) {
+        qWarning() << "Falta el archivo de salida para --export";
+        qWarning() << "Uso: --export archivo.png|archivo.svg [--nodes N] [--seed S] [--tile T] [--max-width W]";
+        qWarning() << "El PNG se escala para no superar --max-width (por defecto 32768 px): con muchos nodos no se lee";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, std::max(1, nodes) * 10);
+    std::vector<int> keys(std::max(0, nodes));
+    for (auto& k : keys) k = dist(rng);
+    Treap<int> tree;
+    size_t added = tree.insertBatch(keys);
+    qInfo() << "Treap generado:" << added << "nodos, altura" << tree.height() << "-" << timer.restart() << "ms";
+
+    bool ok = path.endsWith(".svg", Qt::CaseInsensitive)
+                  ? exportSvg(tree.getRoot(), path)
+                  : exportPng(tree.getRoot(), path, opt);
+    if (!ok) { qWarning() << "No se pudo escribir" << path; return 1; }
+
+    qInfo() << "Exportado a" << path << "-" << timer.elapsed() << "ms";
+    return 0;
+}
+
+} // namespace TreapExport
+
+#endif // TREAPEXPORT_H
@@ -0,0 +1,136 @@
+#ifndef TREAPLAYOUT_H
+#define TREAPLAYOUT_H
+
+#include <QPointF>
+#include <unordered_map>
+#include <algorithm>
+#include "treap.h"
+
+// Reglas de posicionamiento de nodos compartidas por la vista interactiva
+// (MainWindow) y la exportación sin pantalla (treapexport.h).
+//
+// Layout compacto de Reingold–Tilford (versión lineal de Walker/Buchheim para
+// árboles binarios): cada subárbol se dibuja una sola vez y los hermanos se
+// acercan todo lo que permiten sus contornos, en lugar de separarlos por el
+// tamaño total del subárbol. Un hijo único se desplaza hacia su lado para que
+// se siga leyendo como hijo izquierdo o derecho.
+namespace TreapLayout {
+
+constexpr int LEVEL_HEIGHT = 80;     // separación vertical entre niveles
+constexpr int NODE_SEPARATION = 70;  // distancia mínima entre nodos del mismo nivel
+constexpr int SINGLE_CHILD_OFFSET = NODE_SEPARATION / 2;
+
+template <typename TK>
+class Tidy {
+    typedef TreapNode<TK> Node;
+
+    struct Aux {
+        qreal prelim = 0;
+        qreal mod = 0;
+        Node* thread = nullptr;
+    };
+
+    Node* root = nullptr;
+    std::unordered_map<const Node*, Aux> aux;
+    qreal rootX = 0;
+
+    static Node* nextLeft(Node* v, const Aux& a) { return v->left ? v->left : (v->right ? v->right : a.thread); }
+    static Node* nextRight(Node* v, const Aux& a) { return v->right ? v->right : (v->left ? v->left : a.thread); }
+
+    // Acerca el subárbol derecho al izquierdo recorriendo ambos contornos en paralelo
+    // y enhebra el contorno más corto con el más largo (Buchheim et al., 2002)
+    void apportion(Node* left, Node* right) {
+        Node* vim = left;   // contorno derecho del subárbol izquierdo
+        Node* vip = right;  // contorno izquierdo del subárbol derecho
+        Node* vom = left;   // contorno izquierdo del subárbol izquierdo
+        Node* vop = right;  // contorno derecho del subárbol derecho
+        qreal sim = aux[vim].mod, sip = aux[vip].mod, som = aux[vom].mod, sop = aux[vop].mod;
+
+        Node* nr = nextRight(vim, aux[vim]);
+        Node* nl = nextLeft(vip, aux[vip]);
+        while (nr && nl) {
+            vim = nr; vip = nl;
+            vom = nextLeft(vom, aux[vom]);
+            vop = nextRight(vop, aux[vop]);
+
+            qreal shift = (aux[vim].prelim + sim) - (aux[vip].prelim + sip) + NODE_SEPARATION;
+            if (shift > 0) {
+                aux[right].prelim += shift;
+                aux[right].mod += shift;
+                sip += shift;
+                sop += shift;
+            }
+            sim += aux[vim].mod; sip += aux[vip].mod;
+            som += aux[vom].mod; sop += aux[vop].mod;
+
+            nr = nextRight(vim, aux[vim]);
+            nl = nextLeft(vip, aux[vip]);
+        }
+
+        if (nr && !nextRight(vop, aux[vop])) {
+            aux[vop].thread = nr;
+            aux[vop].mod += sim - sop;
+        }
+        if (nl && !nextLeft(vom, aux[vom])) {
+            aux[vom].thread = nl;
+            aux[vom].mod += sip - som;
+        }
+    }
+
+    // Post-orden: 'prelim' es la x relativa al hermano izquierdo; 'mod' se suma a los descendientes
+    void firstWalk(Node* v, Node* leftSibling) {
+        qreal midpoint = 0;
+
+        if (v->left && v->right) {
+            firstWalk(v->left, nullptr);
+            firstWalk(v->right, v->left);
+            apportion(v->left, v->right);
+            midpoint = (aux[v->left].prelim + aux[v->right].prelim) / 2;
+        }
+        else if (v->left) {
+            firstWalk(v->left, nullptr);
+            midpoint = aux[v->left].prelim + SINGLE_CHILD_OFFSET;
+        }
+        else if (v->right) {
+            firstWalk(v->right, nullptr);
+            midpoint = aux[v->right].prelim - SINGLE_CHILD_OFFSET;
+        }
+
+        Aux& self = aux[v];
+        if (leftSibling) {
+            self.prelim = aux[leftSibling].prelim + NODE_SEPARATION;
+            self.mod = self.prelim - midpoint;
+        } else {
+            self.prelim = midpoint;
+        }
+    }
+
+    template <typename Visit>
+    void secondWalk(Node* v, qreal m, qreal y, const QPointF& origin, const QPointF* parentPos, Visit& fn) const {
+        const Aux& a = aux.at(v);
+        QPointF pos(origin.x() + a.prelim + m - rootX, y);
+        if (!fn(v, pos, parentPos)) return;
+        if (v->left) secondWalk(v->left, m + a.mod, y + LEVEL_HEIGHT, origin, &pos, fn);
+        if (v->right) secondWalk(v->right, m + a.mod, y + LEVEL_HEIGHT, origin, &pos, fn);
+    }
+
+public:
+    explicit Tidy(Node* r) : root(r) {
+        if (!root) return;
+        aux.reserve(1024);
+        firstWalk(root, nullptr);
+        rootX = aux[root].prelim;
+    }
+
+    // Recorre el árbol en preorden con la posición de cada nodo, con la raíz en 'rootPos'.
+    // visit(node, pos, parentPos) recibe nullptr como parentPos en la raíz y devuelve
+    // false si no hace falta bajar a sus hijos (permite podar por regiones).
+    template <typename Visit>
+    void visit(QPointF rootPos, Visit fn) const {
+        if (root) secondWalk(root, 0, rootPos.y(), rootPos, nullptr, fn);
+    }
+};
+
+} // namespace TreapLayout
+
+#endif // TREAPLAYOUT_H
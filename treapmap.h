@@ -0,0 +1,214 @@
+#ifndef TREAPMAP_H
+#define TREAPMAP_H
+
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include "treapcore.h"
+
+// --- POLÍTICAS DE AGREGACIÓN ---
+// Una política es un monoide sobre los valores: identity(), lift(valor) y
+// combine(a, b) asociativo (se respeta el orden de las claves). 'enabled = false'
+// elimina el campo del nodo y todo el mantenimiento en tiempo de compilación.
+
+struct NoAggregate {
+    static constexpr bool enabled = false;
+};
+
+template <typename TV>
+struct SumAggregate {
+    static constexpr bool enabled = true;
+    typedef TV value_type;
+    static TV identity() { return TV(); }
+    static TV lift(const TV& v) { return v; }
+    static TV combine(const TV& a, const TV& b) { return a + b; }
+};
+
+template <typename TV>
+struct MinAggregate {
+    static constexpr bool enabled = true;
+    typedef TV value_type;
+    static TV identity() { return std::numeric_limits<TV>::max(); }
+    static TV lift(const TV& v) { return v; }
+    static TV combine(const TV& a, const TV& b) { return std::min(a, b); }
+};
+
+template <typename TV>
+struct MaxAggregate {
+    static constexpr bool enabled = true;
+    typedef TV value_type;
+    static TV identity() { return std::numeric_limits<TV>::lowest(); }
+    static TV lift(const TV& v) { return v; }
+    static TV combine(const TV& a, const TV& b) { return std::max(a, b); }
+};
+
+// Campo del agregado; vacío (y sin costo por EBO) si la política está desactivada
+template <typename Agg, bool = Agg::enabled>
+struct AggregateSlot {};
+
+template <typename Agg>
+struct AggregateSlot<Agg, true> {
+    typename Agg::value_type agg;
+};
+
+template <typename TK, typename TV, typename Agg>
+struct TreapMapNode : AggregateSlot<Agg> {
+    TK key;
+    TV value;
+    int priority;
+    TreapMapNode* left;
+    TreapMapNode* right;
+
+    TreapMapNode(const TK& key_, const TV& value_, const int& priority_)
+        : key(key_), value(value_), priority(priority_), left(nullptr), right(nullptr) {}
+};
+
+// Treap clave -> valor que mantiene el agregado de cada subárbol a través de
+// rotaciones, split y join, para responder consultas de rango en O(log n).
+template <typename TK, typename TV, typename Agg = NoAggregate>
+class TreapMap {
+public:
+    typedef TreapMapNode<TK, TV, Agg> Node;
+
+private:
+    Node* root;
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> dist;
+
+    // Recalcula el agregado del nodo a partir de sus hijos (ver TreapCore)
+    struct Pull {
+        static void pull(Node* node) {
+            if constexpr (Agg::enabled) {
+                auto a = Agg::lift(node->value);
+                if (node->left) a = Agg::combine(node->left->agg, a);
+                if (node->right) a = Agg::combine(a, node->right->agg);
+                node->agg = a;
+            }
+        }
+    };
+    typedef TreapCore<Node, Pull> Core;
+    static void pull(Node* node) { Pull::pull(node); }
+
+    void insert(Node*& node, const TK& key, const TV& value, const int& priority) {
+        if (node == nullptr) { node = new Node(key, value, priority); pull(node); return; }
+        if (key < node->key) {
+            insert(node->left, key, value, priority);
+            pull(node);
+            if (node->left->priority > node->priority) Core::rotateRight(node);
+        }
+        else if (node->key < key) {
+            insert(node->right, key, value, priority);
+            pull(node);
+            if (node->right->priority > node->priority) Core::rotateLeft(node);
+        }
+        else { node->value = value; pull(node); }
+    }
+
+    bool recTreapDelete(Node*& node, const TK& key) {
+        if (node == nullptr) return false;
+        bool removed;
+        if (key < node->key) removed = recTreapDelete(node->left, key);
+        else if (node->key < key) removed = recTreapDelete(node->right, key);
+        else { Core::rootDelete(node); return true; }
+        if (removed) pull(node);
+        return removed;
+    }
+
+public:
+    TreapMap() : root(nullptr), rng(std::random_device{}()), dist(1, 1000000) {}
+    ~TreapMap() { Core::clear(root); }
+
+    TreapMap(const TreapMap&) = delete;
+    TreapMap& operator=(const TreapMap&) = delete;
+
+    // Inserta la clave o reemplaza su valor
+    void insert(const TK& key, const TV& value) { insert(root, key, value, dist(rng)); }
+    void insert(const TK& key, const TV& value, const int& priority) { insert(root, key, value, priority); }
+    bool remove(const TK& key) { return recTreapDelete(root, key); }
+
+    const TV* find(const TK& key) const {
+        Node* current = root;
+        while (current != nullptr) {
+            if (key < current->key) current = current->left;
+            else if (current->key < key) current = current->right;
+            else return &current->value;
+        }
+        return nullptr;
+    }
+
+    // T1 recibe las claves <= key y T2 las mayores; este mapa queda vacío
+    void split(const TK& key, TreapMap& T1, TreapMap& T2) {
+        if (&T1 == this || &T2 == this) throw std::invalid_argument("Invalid treap references");
+        if (T1.root != nullptr || T2.root != nullptr) throw std::invalid_argument("Target treaps must be empty");
+        Core::splitNode(root, key, T1.root, T2.root);
+        root = nullptr;
+    }
+
+    void join(TreapMap& T1, TreapMap& T2) {
+        if (this->root != nullptr) throw std::runtime_error("Join target must be empty");
+        if (T1.root && T2.root && !(T1.maxKey() < T2.minKey()))
+            throw std::invalid_argument("join(): T1 keys must be smaller than T2 keys");
+        root = Core::mergeNodes(T1.root, T2.root);
+        T1.root = nullptr;
+        T2.root = nullptr;
+    }
+
+    // Agregado de los valores con clave en [lo, hi], en O(log n)
+    template <typename A = Agg>
+    typename A::value_type query(const TK& lo, const TK& hi) const {
+        static_assert(A::enabled, "query() needs an aggregation policy");
+        typedef typename A::value_type V;
+
+        // Primer nodo dentro del rango: ahí se separan los caminos hacia lo y hacia hi
+        Node* fork = root;
+        while (fork && (fork->key < lo || hi < fork->key))
+            fork = fork->key < lo ? fork->right : fork->left;
+        if (!fork) return A::identity();
+
+        // Claves >= lo en el subárbol izquierdo (se acumulan de derecha a izquierda)
+        V left = A::identity();
+        for (Node* n = fork->left; n;) {
+            if (n->key < lo) { n = n->right; continue; }
+            V part = A::lift(n->value);
+            if (n->right) part = A::combine(part, n->right->agg);
+            left = A::combine(part, left);
+            n = n->left;
+        }
+
+        // Claves <= hi en el subárbol derecho (de izquierda a derecha)
+        V right = A::identity();
+        for (Node* n = fork->right; n;) {
+            if (hi < n->key) { n = n->left; continue; }
+            V part = A::lift(n->value);
+            if (n->left) part = A::combine(n->left->agg, part);
+            right = A::combine(right, part);
+            n = n->right;
+        }
+
+        return A::combine(A::combine(left, A::lift(fork->value)), right);
+    }
+
+    // Agregado de todo el mapa en O(1)
+    template <typename A = Agg>
+    typename A::value_type total() const {
+        static_assert(A::enabled, "total() needs an aggregation policy");
+        return root ? root->agg : A::identity();
+    }
+
+    TK maxKey() const {
+        if (root == nullptr) throw std::runtime_error("maxKey(): empty treap");
+        return Core::maxNode(root)->key;
+    }
+
+    TK minKey() const {
+        if (root == nullptr) throw std::runtime_error("minKey(): empty treap");
+        return Core::minNode(root)->key;
+    }
+
+    void clear() { Core::clear(root); }
+    bool empty() const { return root == nullptr; }
+    Node* getRoot() const { return root; }
+};
+
+#endif // TREAPMAP_H
@@ -0,0 +1,174 @@
+#ifndef TREAPMULTISET_H
+#define TREAPMULTISET_H
+
+#include <random>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include "treapcore.h"
+
+template <typename TK>
+struct TreapMultisetNode {
+    TK key;
+    size_t count;   // repeticiones de esta clave
+    size_t total;   // suma de 'count' en el subárbol
+    int priority;
+    TreapMultisetNode* left;
+    TreapMultisetNode* right;
+
+    TreapMultisetNode(const TK& key_, const int& priority_)
+        : key(key_), count(1), total(1), priority(priority_), left(nullptr), right(nullptr) {}
+};
+
+// Treap con claves repetidas: cada clave distinta es un solo nodo con su contador.
+// Repetir o quitar una repetición es un descenso y un incremento (sin reservar
+// memoria ni rotar); rank y conteo por rango cuentan las multiplicidades.
+template <typename TK>
+class TreapMultiset {
+public:
+    typedef TreapMultisetNode<TK> Node;
+
+private:
+    Node* root;
+    std::mt19937 rng;
+    std::uniform_int_distribution<int> dist;
+
+    static size_t total(Node* node) { return node ? node->total : 0; }
+
+    // Recalcula el total del nodo a partir de sus hijos (ver TreapCore)
+    struct Pull {
+        static void pull(Node* node) { node->total = total(node->left) + node->count + total(node->right); }
+    };
+    typedef TreapCore<Node, Pull> Core;
+
+    // El total de cada nodo del camino crece en 'times' tanto si la clave es nueva como
+    // si ya estaba; solo una clave nueva puede subir por prioridad. 'priority' se
+    // llama únicamente al crear el nodo: repetir una clave no consume el generador.
+    template <typename Priority>
+    static void insert(Node*& node, const TK& key, size_t times, Priority& priority) {
+        if (node == nullptr) { node = new Node(key, priority()); node->count = node->total = times; return; }
+        node->total += times;
+        if (key < node->key) {
+            insert(node->left, key, times, priority);
+            if (node->left->priority > node->priority) Core::rotateRight(node);
+        }
+        else if (node->key < key) {
+            insert(node->right, key, times, priority);
+            if (node->right->priority > node->priority) Core::rotateLeft(node);
+        }
+        else node->count += times;
+    }
+
+    // Quita hasta 'times' repeticiones y devuelve cuántas quitó
+    size_t erase(Node*& node, const TK& key, size_t times) {
+        if (node == nullptr) return 0;
+        size_t removed;
+        if (key < node->key) removed = erase(node->left, key, times);
+        else if (node->key < key) removed = erase(node->right, key, times);
+        else if (node->count > times) { node->count -= times; removed = times; }
+        else { removed = node->count; Core::rootDelete(node); return removed; }
+        node->total -= removed;
+        return removed;
+    }
+
+public:
+    TreapMultiset() : root(nullptr), rng(std::random_device{}()), dist(1, 1000000) {}
+    ~TreapMultiset() { Core::clear(root); }
+
+    TreapMultiset(const TreapMultiset&) = delete;
+    TreapMultiset& operator=(const TreapMultiset&) = delete;
+
+    // Agrega 'times' repeticiones de la clave
+    void insert(const TK& key, size_t times = 1) {
+        auto draw = [this] { return dist(rng); };
+        if (times) insert(root, key, times, draw);
+    }
+    void insert(const TK& key, size_t times, const int& priority) {
+        auto fixed = [priority] { return priority; };
+        if (times) insert(root, key, times, fixed);
+    }
+
+    // Quita una repetición; devuelve false si la clave no estaba
+    bool erase(const TK& key) { return erase(root, key, 1) != 0; }
+    // Quita todas las repeticiones y devuelve cuántas eran
+    size_t eraseAll(const TK& key) { return erase(root, key, size_t(-1)); }
+
+    size_t count(const TK& key) const {
+        Node* current = root;
+        while (current != nullptr) {
+            if (key < current->key) current = current->left;
+            else if (current->key < key) current = current->right;
+            else return current->count;
+        }
+        return 0;
+    }
+    bool search(const TK& key) const { return count(key) != 0; }
+
+    // Elementos (con repeticiones) estrictamente menores que key, en O(log n)
+    size_t rank(const TK& key) const {
+        size_t r = 0;
+        for (Node* current = root; current != nullptr;) {
+            if (current->key < key) { r += total(current->left) + current->count; current = current->right; }
+            else current = current->left;
+        }
+        return r;
+    }
+
+    // Elementos (con repeticiones) con clave en [lo, hi]
+    size_t countRange(const TK& lo, const TK& hi) const {
+        if (hi < lo) return 0;
+        size_t upTo = 0; // elementos <= hi
+        for (Node* current = root; current != nullptr;) {
+            if (hi < current->key) current = current->left;
+            else { upTo += total(current->left) + current->count; current = current->right; }
+        }
+        return upTo - rank(lo);
+    }
+
+    // k-ésimo elemento en orden (desde 0) contando repeticiones
+    const TK& kth(size_t k) const {
+        if (k >= size()) throw std::out_of_range("kth(): index out of range");
+        Node* current = root;
+        while (true) {
+            size_t left = total(current->left);
+            if (k < left) current = current->left;
+            else if (k < left + current->count) return current->key;
+            else { k -= left + current->count; current = current->right; }
+        }
+    }
+
+    // T1 recibe las claves <= key y T2 las mayores; este multiconjunto queda vacío
+    void split(const TK& key, TreapMultiset& T1, TreapMultiset& T2) {
+        if (&T1 == this || &T2 == this) throw std::invalid_argument("Invalid treap references");
+        if (T1.root != nullptr || T2.root != nullptr) throw std::invalid_argument("Target treaps must be empty");
+        Core::splitNode(root, key, T1.root, T2.root);
+        root = nullptr;
+    }
+
+    void join(TreapMultiset& T1, TreapMultiset& T2) {
+        if (this->root != nullptr) throw std::runtime_error("Join target must be empty");
+        if (T1.root && T2.root && !(T1.maxKey() < T2.minKey()))
+            throw std::invalid_argument("join(): T1 keys must be smaller than T2 keys");
+        root = Core::mergeNodes(T1.root, T2.root);
+        T1.root = nullptr;
+        T2.root = nullptr;
+    }
+
+    TK maxKey() const {
+        if (root == nullptr) throw std::runtime_error("maxKey(): empty treap");
+        return Core::maxNode(root)->key;
+    }
+
+    TK minKey() const {
+        if (root == nullptr) throw std::runtime_error("minKey(): empty treap");
+        return Core::minNode(root)->key;
+    }
+
+    // Cantidad de elementos contando repeticiones, en O(1)
+    size_t size() const { return total(root); }
+    void clear() { Core::clear(root); }
+    bool empty() const { return root == nullptr; }
+    Node* getRoot() const { return root; }
+};
+
+#endif // TREAPMULTISET_H
@@ -0,0 +1,81 @@
+#ifndef TREAPRECLAIMER_H
+#define TREAPRECLAIMER_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+// Hilo de fondo que libera subárboles ya separados de su treap (eraseRange,
+// clearDeferred). Quien llama solo encola un puntero y sigue; borrar millones
+// de nodos no lo bloquea. Los trabajos se ejecutan en orden de llegada.
+class TreapReclaimer {
+public:
+    typedef std::function<void()> Job;
+
+    static TreapReclaimer& instance() {
+        static TreapReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    void post(Job job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(job));
+            pending++;
+        }
+        cv.notify_one();
+    }
+
+    // Espera a que se liberen todos los subárboles encolados hasta ahora
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+
+    TreapReclaimer(const TreapReclaimer&) = delete;
+    TreapReclaimer& operator=(const TreapReclaimer&) = delete;
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable idle;
+    std::vector<Job> queue;
+    size_t pending = 0;
+    bool stopping = false;
+    std::thread thread; // último: arranca con todo lo anterior ya construido
+
+    TreapReclaimer() : thread(&TreapReclaimer::run, this) {}
+
+    // Al salir del programa se termina de liberar lo pendiente
+    ~TreapReclaimer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        thread.join();
+    }
+
+    void run() {
+        std::vector<Job> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return !queue.empty() || stopping; });
+                if (queue.empty()) return;
+                batch.swap(queue);
+            }
+            for (Job& job : batch) job();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending -= batch.size();
+                if (pending == 0) idle.notify_all();
+            }
+            batch.clear();
+        }
+    }
+};
+
+#endif // TREAPRECLAIMER_H
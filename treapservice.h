@@ -0,0 +1,268 @@
+#ifndef TREAPSERVICE_H
+#define TREAPSERVICE_H
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Protocolo binario del servicio de treaps (treapd) sobre un socket Unix.
+//
+// Cada mensaje es un frame: [u32 longitud del resto][u32 id][u8 código][datos].
+// En los pedidos el código es la operación y en las respuestas el estado; la
+// respuesta lleva el id del pedido, así que el cliente puede mandar muchos
+// pedidos seguidos sin esperar (pipelining) y las respuestas de treaps distintos
+// pueden llegar en otro orden. Los enteros van en el orden de bytes del host
+// (el socket es local); los nombres como u16 + bytes y los lotes como u32 + i32[].
+namespace TreapService {
+
+constexpr uint32_t MAX_FRAME = 64u << 20;
+// Claves que entran en una respuesta de Range sin pasar MAX_FRAME (id, estado y
+// u32 de cantidad incluidos); el servidor recorta a esto el límite pedido
+constexpr uint32_t MAX_RANGE_KEYS = (MAX_FRAME - 2 * sizeof(uint32_t) - 1) / sizeof(int32_t);
+constexpr const char* DEFAULT_SOCKET = "/tmp/treapd.sock";
+
+enum class Op : uint8_t {
+    Create = 1,  // nombre
+    Drop = 2,    // nombre
+    Insert = 3,  // nombre, claves            -> u32 agregadas
+    Erase = 4,   // nombre, claves            -> u32 quitadas
+    Search = 5,  // nombre, claves            -> u32 n + u8[n] (1 si está)
+    Range = 6,   // nombre, lo, hi, u32 límite -> claves en [lo, hi] (a lo sumo MAX_RANGE_KEYS)
+    Split = 7,   // origen, clave, izquierdo, derecho
+    Join = 8,    // menor, mayor, resultado
+};
+
+enum class Status : uint8_t {
+    Ok = 0,
+    UnknownTreap = 1,
+    AlreadyExists = 2,
+    BadRequest = 3,
+    Invalid = 4,        // p. ej. join con rangos solapados
+    Busy = 5,           // el nombre está reservado por un split/join en curso; reintentar
+};
+
+inline const char* statusName(Status s) {
+    switch (s) {
+    case Status::Ok: return "ok";
+    case Status::UnknownTreap: return "unknown treap";
+    case Status::AlreadyExists: return "already exists";
+    case Status::BadRequest: return "bad request";
+    case Status::Invalid: return "invalid";
+    case Status::Busy: return "busy";
+    }
+    return "?";
+}
+
+// Arma uno o varios frames seguidos en un solo buffer (un write por tanda)
+class Encoder {
+    std::string buf;
+    size_t start = 0;
+
+public:
+    template <typename T>
+    void put(T v) { buf.append(reinterpret_cast<const char*>(&v), sizeof v); }
+
+    void putName(const std::string& s) {
+        if (s.size() > UINT16_MAX) throw std::length_error("treap name too long");
+        put<uint16_t>(uint16_t(s.size()));
+        buf.append(s);
+    }
+
+    void putKeys(const std::vector<int>& keys) {
+        put<uint32_t>(uint32_t(keys.size()));
+        buf.append(reinterpret_cast<const char*>(keys.data()), keys.size() * sizeof(int));
+    }
+
+    void putBytes(const char* data, size_t size) { buf.append(data, size); }
+
+    void begin(uint32_t id, uint8_t code) {
+        start = buf.size();
+        put<uint32_t>(0);
+        put<uint32_t>(id);
+        put<uint8_t>(code);
+    }
+
+    void end() {
+        uint32_t length = uint32_t(buf.size() - start - sizeof(uint32_t));
+        std::memcpy(&buf[start], &length, sizeof length);
+    }
+
+    // --- Pedidos ---
+    void create(uint32_t id, const std::string& name) { begin(id, uint8_t(Op::Create)); putName(name); end(); }
+    void drop(uint32_t id, const std::string& name) { begin(id, uint8_t(Op::Drop)); putName(name); end(); }
+
+    void batch(uint32_t id, Op op, const std::string& name, const std::vector<int>& keys) {
+        begin(id, uint8_t(op)); putName(name); putKeys(keys); end();
+    }
+
+    void range(uint32_t id, const std::string& name, int lo, int hi, uint32_t limit) {
+        begin(id, uint8_t(Op::Range)); putName(name); put<int32_t>(lo); put<int32_t>(hi); put<uint32_t>(limit); end();
+    }
+
+    void split(uint32_t id, const std::string& source, int key, const std::string& left, const std::string& right) {
+        begin(id, uint8_t(Op::Split)); putName(source); put<int32_t>(key); putName(left); putName(right); end();
+    }
+
+    void join(uint32_t id, const std::string& lower, const std::string& upper, const std::string& result) {
+        begin(id, uint8_t(Op::Join)); putName(lower); putName(upper); putName(result); end();
+    }
+
+    // --- Respuestas sin datos o de error ---
+    void status(uint32_t id, Status s, const std::string& message = std::string()) {
+        begin(id, uint8_t(s));
+        if (s != Status::Ok) putName(message);
+        end();
+    }
+
+    const std::string& data() const { return buf; }
+    bool empty() const { return buf.empty(); }
+    void clear() { buf.clear(); }
+};
+
+struct Frame {
+    uint32_t id = 0;
+    uint8_t code = 0;
+    const char* data = nullptr; // válido hasta la siguiente lectura
+    size_t size = 0;
+};
+
+// Lee los campos de un frame; lanza si el frame está truncado
+class Decoder {
+    const char* p;
+    const char* end;
+
+    void need(size_t n) const {
+        if (size_t(end - p) < n) throw std::runtime_error("truncated frame");
+    }
+
+public:
+    explicit Decoder(const Frame& f) : p(f.data), end(f.data + f.size) {}
+
+    template <typename T>
+    T get() {
+        need(sizeof(T));
+        T v;
+        std::memcpy(&v, p, sizeof v);
+        p += sizeof v;
+        return v;
+    }
+
+    std::string getName() {
+        uint16_t n = get<uint16_t>();
+        need(n);
+        std::string s(p, n);
+        p += n;
+        return s;
+    }
+
+    void getKeys(std::vector<int>& keys) {
+        uint32_t n = get<uint32_t>();
+        need(size_t(n) * sizeof(int));
+        keys.resize(n);
+        std::memcpy(keys.data(), p, size_t(n) * sizeof(int));
+        p += size_t(n) * sizeof(int);
+    }
+
+    const char* bytes(size_t n) { need(n); const char* b = p; p += n; return b; }
+};
+
+// Escribe todo el buffer (el proceso debe ignorar SIGPIPE)
+inline bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= size_t(n);
+    }
+    return true;
+}
+
+// Lectura con buffer: un read() trae varios frames cuando el otro lado los encadena
+class FrameReader {
+    int fd;
+    std::vector<char> buf;
+    size_t begin = 0, end = 0;
+
+    bool fill(size_t need) {
+        if (buf.size() - begin < need) {
+            std::memmove(buf.data(), buf.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+            if (buf.size() < need) buf.resize(need);
+        }
+        while (end - begin < need) {
+            ssize_t n = ::read(fd, buf.data() + end, buf.size() - end);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            end += size_t(n);
+        }
+        return true;
+    }
+
+public:
+    explicit FrameReader(int fd_) : fd(fd_), buf(64 * 1024) {}
+
+    // false al cerrarse la conexión o si llega un frame inválido
+    bool next(Frame& f) {
+        const size_t header = 2 * sizeof(uint32_t) + 1;
+        if (!fill(sizeof(uint32_t))) return false;
+        uint32_t length;
+        std::memcpy(&length, buf.data() + begin, sizeof length);
+        if (length < header - sizeof(uint32_t) || length > MAX_FRAME) return false;
+        if (!fill(sizeof(uint32_t) + length)) return false;
+
+        const char* p = buf.data() + begin + sizeof(uint32_t);
+        std::memcpy(&f.id, p, sizeof f.id);
+        f.code = uint8_t(p[sizeof f.id]);
+        f.data = p + header - sizeof(uint32_t);
+        f.size = length - (header - sizeof(uint32_t));
+        begin += sizeof(uint32_t) + length;
+        return true;
+    }
+};
+
+// Cliente mínimo: conectar, mandar tandas de pedidos y leer respuestas de a una
+class Client {
+    int fd = -1;
+    std::unique_ptr<FrameReader> reader;
+
+public:
+    Client() = default;
+    ~Client() { close(); }
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    bool connect(const std::string& path) {
+        close();
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) return false;
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, path.c_str());
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) { close(); return false; }
+        reader = std::make_unique<FrameReader>(fd);
+        return true;
+    }
+
+    bool send(const Encoder& e) { return writeAll(fd, e.data().data(), e.data().size()); }
+    bool receive(Frame& f) { return reader && reader->next(f); }
+
+    void close() {
+        reader.reset();
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+};
+
+} // namespace TreapService
+
+#endif // TREAPSERVICE_H
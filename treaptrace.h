@@ -0,0 +1,276 @@
+#ifndef TREAPTRACE_H
+#define TREAPTRACE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <chrono>
+#include <stdexcept>
+#include "treap.h"
+
+// Registro binario de las operaciones del espacio de trabajo (varios treaps con nombre)
+// y reproducción sin interfaz gráfica.
+//
+// Formato: "TRTR" + versión (1 byte), seguido de registros [op (1 byte)][campos].
+// Los enteros van en varint zigzag, los textos como varint de longitud + UTF-8, y
+// los lotes de claves como diferencias con la clave anterior.
+namespace TreapTrace {
+
+constexpr char MAGIC[4] = { 'T', 'R', 'T', 'R' };
+// Versión 2 agrega EraseRange; las trazas de la versión 1 se siguen leyendo
+constexpr uint8_t VERSION = 2;
+
+enum class Op : uint8_t {
+    Create = 1,       // nombre
+    DeleteTreap = 2,  // nombre
+    Insert = 3,       // nombre, clave, prioridad
+    Remove = 4,       // nombre, clave
+    Split = 5,        // origen, clave, izquierdo, derecho
+    Join = 6,         // menor, mayor, resultado
+    InsertBatch = 7,  // nombre, semilla de prioridades, claves
+    EraseBatch = 8,   // nombre, claves
+    EraseRange = 9,   // nombre, desde, hasta
+};
+
+inline const char* opName(Op op) {
+    switch (op) {
+    case Op::Create: return "create";
+    case Op::DeleteTreap: return "delete-treap";
+    case Op::Insert: return "insert";
+    case Op::Remove: return "remove";
+    case Op::Split: return "split";
+    case Op::Join: return "join";
+    case Op::InsertBatch: return "insert-batch";
+    case Op::EraseBatch: return "erase-batch";
+    case Op::EraseRange: return "erase-range";
+    }
+    return "?";
+}
+
+struct Record {
+    Op op = Op::Create;
+    std::string name, second, third;
+    int32_t key = 0;
+    int32_t priority = 0;   // prioridad en Insert, semilla en InsertBatch
+    int32_t last = 0;       // fin del rango en EraseRange
+    std::vector<int32_t> keys;
+};
+
+// Escribe con el buffer de std::ofstream: no hay una llamada al sistema por
+// operación. Lo pendiente llega al disco con flush() (MainWindow lo llama una vez
+// por frame), cuando se llena el buffer y al destruir el Writer. Si la app se cae,
+// se pierde lo que no llegó a flush() y el último registro puede quedar cortado
+// (la reproducción lo informa como "truncated record").
+class Writer {
+    std::ofstream out;
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) { out.put(char(v | 0x80)); v >>= 7; }
+        out.put(char(v));
+    }
+    void putInt(int64_t v) { putVarint((uint64_t(v) << 1) ^ uint64_t(v >> 63)); }
+    void putString(const std::string& s) { putVarint(s.size()); out.write(s.data(), s.size()); }
+    void putKeys(const std::vector<int32_t>& keys) {
+        putVarint(keys.size());
+        int64_t prev = 0;
+        for (int32_t k : keys) { putInt(int64_t(k) - prev); prev = k; }
+    }
+    void begin(Op op) { out.put(char(op)); }
+
+public:
+    bool open(const std::string& path) {
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(MAGIC, 4);
+        out.put(char(VERSION));
+        return bool(out);
+    }
+    bool isOpen() const { return out.is_open(); }
+    void flush() { out.flush(); }
+
+    void create(const std::string& name) { begin(Op::Create); putString(name); }
+    void deleteTreap(const std::string& name) { begin(Op::DeleteTreap); putString(name); }
+
+    void insert(const std::string& name, int32_t key, int32_t priority) {
+        begin(Op::Insert); putString(name); putInt(key); putInt(priority);
+    }
+    void remove(const std::string& name, int32_t key) {
+        begin(Op::Remove); putString(name); putInt(key);
+    }
+    void split(const std::string& source, int32_t key, const std::string& left, const std::string& right) {
+        begin(Op::Split); putString(source); putInt(key); putString(left); putString(right);
+    }
+    void join(const std::string& lower, const std::string& upper, const std::string& result) {
+        begin(Op::Join); putString(lower); putString(upper); putString(result);
+    }
+    void insertBatch(const std::string& name, uint32_t seed, const std::vector<int32_t>& keys) {
+        begin(Op::InsertBatch); putString(name); putInt(int32_t(seed)); putKeys(keys);
+    }
+    void eraseBatch(const std::string& name, const std::vector<int32_t>& keys) {
+        begin(Op::EraseBatch); putString(name); putKeys(keys);
+    }
+    void eraseRange(const std::string& name, int32_t lo, int32_t hi) {
+        begin(Op::EraseRange); putString(name); putInt(lo); putInt(hi);
+    }
+};
+
+class Reader {
+    std::ifstream in;
+
+    uint64_t getVarint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int c = in.get();
+            if (c == EOF) throw std::runtime_error("trace: truncated record");
+            v |= uint64_t(c & 0x7F) << shift;
+            if (!(c & 0x80)) return v;
+        }
+        throw std::runtime_error("trace: bad varint");
+    }
+    int64_t getInt() { uint64_t v = getVarint(); return int64_t(v >> 1) ^ -int64_t(v & 1); }
+    std::string getString() {
+        std::string s(getVarint(), '\0');
+        in.read(&s[0], s.size());
+        if (!in) throw std::runtime_error("trace: truncated string");
+        return s;
+    }
+    void getKeys(std::vector<int32_t>& keys) {
+        keys.resize(getVarint());
+        int64_t prev = 0;
+        for (auto& k : keys) { prev += getInt(); k = int32_t(prev); }
+    }
+
+public:
+    bool open(const std::string& path) {
+        in.open(path, std::ios::binary);
+        char magic[4];
+        if (!in.read(magic, 4) || !std::equal(magic, magic + 4, MAGIC)) return false;
+        int version = in.get();
+        return version >= 1 && version <= VERSION;
+    }
+
+    // Devuelve false al llegar al final del archivo
+    bool next(Record& r) {
+        int c = in.get();
+        if (c == EOF) return false;
+        r.op = Op(c);
+        r.keys.clear();
+        switch (r.op) {
+        case Op::Create:
+        case Op::DeleteTreap:
+            r.name = getString(); break;
+        case Op::Insert:
+            r.name = getString(); r.key = int32_t(getInt()); r.priority = int32_t(getInt()); break;
+        case Op::Remove:
+            r.name = getString(); r.key = int32_t(getInt()); break;
+        case Op::Split:
+            r.name = getString(); r.key = int32_t(getInt()); r.second = getString(); r.third = getString(); break;
+        case Op::Join:
+            r.name = getString(); r.second = getString(); r.third = getString(); break;
+        case Op::InsertBatch:
+            r.name = getString(); r.priority = int32_t(getInt()); getKeys(r.keys); break;
+        case Op::EraseBatch:
+            r.name = getString(); getKeys(r.keys); break;
+        case Op::EraseRange:
+            r.name = getString(); r.key = int32_t(getInt()); r.last = int32_t(getInt()); break;
+        default:
+            throw std::runtime_error("trace: unknown operation " + std::to_string(c));
+        }
+        return true;
+    }
+};
+
+// Tiempo acumulado por tipo de operación
+struct OpStats {
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+};
+
+struct ReplayResult {
+    uint64_t operations = 0;
+    double seconds = 0;
+    std::map<Op, OpStats> perOp; // solo se llena con timing activado
+};
+
+// Re-ejecuta la traza contra el motor tan rápido como se pueda.
+// Con 'timing' mide cada operación por separado (agrega algo de costo).
+inline ReplayResult replay(const std::string& path, bool timing) {
+    typedef std::chrono::steady_clock Clock;
+    Reader reader;
+    if (!reader.open(path)) throw std::runtime_error("trace: cannot open " + path);
+
+    std::map<std::string, std::unique_ptr<Treap<int>>> treaps;
+    auto get = [&](const std::string& name) -> Treap<int>& {
+        auto it = treaps.find(name);
+        if (it == treaps.end()) throw std::runtime_error("trace: unknown treap " + name);
+        return *it->second;
+    };
+
+    ReplayResult result;
+    Record r;
+    auto start = Clock::now();
+    while (reader.next(r)) {
+        auto opStart = timing ? Clock::now() : Clock::time_point();
+        switch (r.op) {
+        case Op::Create:
+            treaps[r.name] = std::make_unique<Treap<int>>();
+            break;
+        case Op::DeleteTreap:
+            treaps.erase(r.name);
+            break;
+        case Op::Insert:
+            get(r.name).insert(r.key, r.priority);
+            break;
+        case Op::Remove:
+            get(r.name).remove(r.key);
+            break;
+        case Op::Split: {
+            auto left = std::make_unique<Treap<int>>();
+            auto right = std::make_unique<Treap<int>>();
+            get(r.name).split(r.key, *left, *right);
+            treaps.erase(r.name);
+            treaps[r.second] = std::move(left);
+            treaps[r.third] = std::move(right);
+            break;
+        }
+        case Op::Join: {
+            auto joined = std::make_unique<Treap<int>>();
+            joined->join(get(r.name), get(r.second));
+            treaps.erase(r.name);
+            treaps.erase(r.second);
+            treaps[r.third] = std::move(joined);
+            break;
+        }
+        case Op::InsertBatch: {
+            Treap<int>& t = get(r.name);
+            t.seedPriorities(uint32_t(r.priority));
+            t.insertBatch(std::vector<int>(r.keys.begin(), r.keys.end()));
+            break;
+        }
+        case Op::EraseBatch:
+            get(r.name).eraseBatch(std::vector<int>(r.keys.begin(), r.keys.end()));
+            break;
+        case Op::EraseRange:
+            get(r.name).eraseRange(r.key, r.last);
+            break;
+        }
+        result.operations++;
+        if (timing) {
+            uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - opStart).count();
+            OpStats& s = result.perOp[r.op];
+            s.count++;
+            s.totalNs += ns;
+            s.maxNs = std::max(s.maxNs, ns);
+        }
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+} // namespace TreapTrace
+
+#endif // TREAPTRACE_H
@@ -11,6 +11,7 @@
 #include <QPropertyAnimation>
 #include <QGraphicsSceneMouseEvent>
 #include <QCursor>
+#include <QStaticText>
 
 // --- NODO VISUAL ---
 class VisualNode : public QGraphicsObject {
@@ -29,40 +30,71 @@ public:
         setZValue(10);
         // Cambiar el cursor para indicar que es clickeable
         setCursor(Qt::PointingHandCursor);
+        // El nodo se rasteriza una vez en coordenadas del item, a la resolución de su
+        // boundingRect, y el pixmap se reutiliza al moverlo, desplazar la vista y hacer
+        // zoom (con zoom mayor a 1 se estira). Solo update() lo vuelve a pintar
+        setCacheMode(QGraphicsItem::ItemCoordinateCache, boundingRect().size().toSize());
+        prepareLabels();
     }
 
     QRectF boundingRect() const override {
         return QRectF(-30, -45, 60, 70);
     }
 
-    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override {
-        Q_UNUSED(option); Q_UNUSED(widget);
-        painter->setRenderHint(QPainter::Antialiasing);
+    static const QFont& keyFont() {
+        static const QFont font = [] { QFont f; f.setBold(true); f.setPointSize(10); return f; }();
+        return font;
+    }
 
-        if (isSelected) {
+    static const QFont& priorityFont() {
+        static const QFont font = [] { QFont f; f.setPointSize(8); return f; }();
+        return font;
+    }
+
+    // Círculo del nodo (y anillo de selección) en coordenadas locales
+    static void paintShape(QPainter* painter, const QColor& color, bool selected) {
+        if (selected) {
             painter->setBrush(Qt::NoBrush);
             painter->setPen(QPen(Qt::red, 3));
             painter->drawEllipse(-23, -23, 46, 46);
         }
 
-        painter->setBrush(mainColor);
+        painter->setBrush(color);
         painter->setPen(QPen(Qt::black, 2));
         painter->drawEllipse(-20, -20, 40, 40);
+    }
 
-        QFont font = painter->font();
-        font.setBold(true);
-        font.setPointSize(10);
-        painter->setFont(font);
+    // Dibujo completo sin textos precalculados; lo usa la exportación sin pantalla
+    static void paintNode(QPainter* painter, int key, int priority, const QColor& color, bool selected) {
+        paintShape(painter, color, selected);
+
+        painter->setFont(keyFont());
         painter->setPen(QPen(Qt::black));
         painter->drawText(QRectF(-20, -20, 40, 40), Qt::AlignCenter, QString::number(key));
 
-        font.setBold(false);
-        font.setPointSize(8);
-        painter->setFont(font);
+        painter->setFont(priorityFont());
         painter->setPen(QPen(Qt::darkGray));
         painter->drawText(QRectF(-30, -45, 60, 20), Qt::AlignCenter, QString("p:%1").arg(priority));
     }
 
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override {
+        Q_UNUSED(option); Q_UNUSED(widget);
+        // Se pinta una sola vez sobre el pixmap de la caché y se reutiliza a cualquier
+        // zoom, así que siempre con antialiasing: el modo rápido de ZoomGraphicsView solo
+        // abarata el dibujo del pixmap y de las aristas
+        painter->setRenderHint(QPainter::Antialiasing);
+        paintShape(painter, mainColor, isSelected);
+
+        // Textos ya maquetados en prepareLabels(): no hay shaping en cada repintado
+        painter->setFont(keyFont());
+        painter->setPen(QPen(Qt::black));
+        painter->drawStaticText(keyTextPos, keyText);
+
+        painter->setFont(priorityFont());
+        painter->setPen(QPen(Qt::darkGray));
+        painter->drawStaticText(priorityTextPos, priorityText);
+    }
+
     void setColor(QColor c) {
         if (mainColor != c) { mainColor = c; update(); }
     }
@@ -71,19 +103,58 @@ public:
         if (isSelected != sel) { isSelected = sel; update(); }
     }
 
+    // Reutiliza el item para otro nodo lógico (pool de MainWindow): solo se
+    // vuelven a maquetar los textos si cambian la clave o la prioridad
+    void rebind(int k, int p) {
+        if (key == k && priority == p) return;
+        key = k;
+        priority = p;
+        prepareLabels();
+        update();
+    }
+
+    // Una sola animación por item, reiniciada en cada movimiento
     void animateTo(QPointF endPos) {
+        if (anim && anim->state() == QAbstractAnimation::Running && anim->endValue().toPointF() == endPos) return;
+        stopAnimation();
         if (pos() == endPos) return;
-        QPropertyAnimation* anim = new QPropertyAnimation(this, "pos");
-        anim->setDuration(1000);
+        if (!anim) {
+            anim = new QPropertyAnimation(this, "pos", this);
+            anim->setDuration(1000);
+            anim->setEasingCurve(QEasingCurve::OutQuad);
+        }
         anim->setStartValue(pos());
         anim->setEndValue(endPos);
-        anim->setEasingCurve(QEasingCurve::OutQuad);
-        anim->start(QAbstractAnimation::DeleteWhenStopped);
+        anim->start();
+    }
+
+    void stopAnimation() {
+        if (anim) anim->stop();
     }
 
 signals:
     void nodeClicked(QString ownerName);
 
+private:
+    QPropertyAnimation* anim = nullptr;
+    QStaticText keyText;
+    QStaticText priorityText;
+    QPointF keyTextPos;
+    QPointF priorityTextPos;
+
+    // Maqueta una sola vez los textos de clave y prioridad, centrados como en paintNode()
+    void prepareLabels() {
+        keyText.setTextFormat(Qt::PlainText);
+        keyText.setText(QString::number(key));
+        keyText.prepare(QTransform(), keyFont());
+        keyTextPos = QPointF(-keyText.size().width() / 2, -keyText.size().height() / 2);
+
+        priorityText.setTextFormat(Qt::PlainText);
+        priorityText.setText(QString("p:%1").arg(priority));
+        priorityText.prepare(QTransform(), priorityFont());
+        priorityTextPos = QPointF(-priorityText.size().width() / 2, -35 - priorityText.size().height() / 2);
+    }
+
 protected:
     // --- CORRECCIÓN AQUÍ ---
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override {
@@ -94,7 +165,7 @@ protected:
         QString safeName = ownerName;
 
         // 3. Emitimos la señal AL FINAL.
-        // Esto provocará que MainWindow actualice la vista y posiblemente elimine este objeto 'this'.
+        // MainWindow agenda el refresco de la vista, que puede reciclar o eliminar este objeto 'this'.
         // Por eso, no debemos escribir nada después de esta línea que use 'this'.
         emit nodeClicked(safeName);
 
@@ -109,21 +180,29 @@ class ClickableTreeLabel : public QGraphicsTextItem {
 public:
     QString treeName;
     ClickableTreeLabel(QString name, bool isSelected, bool isEmpty, QGraphicsItem* parent = nullptr)
-        : QGraphicsTextItem(parent), treeName(name) {
-
-        if (isEmpty) setPlainText("[" + name + ": Vacio]");
-        else setPlainText(name);
-
-        setDefaultTextColor(isSelected ? Qt::blue : Qt::black);
+        : QGraphicsTextItem(parent) {
         QFont f = font();
         f.setBold(true);
         f.setPointSize(12);
         setFont(f);
         setCursor(Qt::PointingHandCursor);
         setZValue(5);
+        rebind(name, isSelected, isEmpty);
+    }
+
+    // Reutiliza la etiqueta (pool de MainWindow); el documento solo se vuelve a
+    // maquetar si cambia el texto
+    void rebind(const QString& name, bool isSelected, bool isEmpty) {
+        treeName = name;
+        QString text = isEmpty ? "[" + name + ": Vacio]" : name;
+        if (text != shownText) { shownText = text; setPlainText(text); }
+        QColor color = isSelected ? Qt::blue : Qt::black;
+        if (defaultTextColor() != color) setDefaultTextColor(color);
     }
 signals:
     void labelClicked(QString name);
+private:
+    QString shownText;
 protected:
     // --- CORRECCIÓN AQUÍ TAMBIÉN ---
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override {